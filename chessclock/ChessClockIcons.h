@@ -0,0 +1,63 @@
+/*!
+   @file ChessClockIcons.h
+
+   This is part of the Arduino UNO TFT Chess Clock
+   Run length encoded icons for TFTIconBlitter, generated by host/icon_rle
+   from host/icons/bitmaps.h, do not edit
+
+
+   Written by Enrique Albertos, with
+   contributions from the open source community.
+
+   Public Domain
+
+*/
+
+#ifndef _ChessClockIcons_H_
+#define _ChessClockIcons_H_
+
+#include "arduino.h"
+
+// 'pause', 32x32px, 85 runs
+const uint8_t rle_icon_pause[] PROGMEM = {
+  32, 32,
+  167, 6, 5, 6, 15, 7, 4, 7, 14, 7, 4, 7, 14, 7, 4, 7,
+  14, 7, 4, 7, 14, 7, 4, 7, 14, 7, 4, 7, 14, 7, 4, 7,
+  14, 7, 4, 7, 14, 7, 4, 7, 14, 7, 4, 7, 14, 7, 4, 7,
+  14, 7, 4, 7, 14, 7, 4, 7, 14, 7, 4, 7, 14, 7, 4, 7,
+  14, 7, 4, 7, 14, 7, 4, 7, 14, 7, 4, 7, 14, 7, 4, 7,
+  14, 7, 4, 7, 199
+};
+
+// 'reset', 32x32px, 97 runs
+const uint8_t rle_icon_reset[] PROGMEM = {
+  32, 32,
+  33, 1, 9, 10, 12, 2, 6, 14, 10, 3, 3, 18, 8, 4, 1, 20,
+  7, 26, 6, 27, 5, 11, 7, 10, 4, 10, 10, 8, 4, 9, 12, 8,
+  3, 10, 12, 7, 3, 11, 12, 7, 2, 12, 11, 7, 2, 13, 11, 6,
+  26, 6, 26, 6, 26, 6, 26, 6, 2, 6, 18, 6, 2, 6, 17, 7,
+  2, 7, 16, 7, 3, 7, 14, 7, 4, 7, 13, 8, 5, 8, 10, 8,
+  6, 9, 7, 10, 7, 24, 9, 22, 11, 20, 13, 18, 16, 14, 20, 10,
+  43
+};
+
+// 'settings', 32x32px, 83 runs
+const uint8_t rle_icon_settings[] PROGMEM = {
+  32, 32,
+  13, 6, 26, 6, 26, 6, 18, 3, 4, 8, 4, 3, 9, 24, 7, 26,
+  6, 26, 6, 26, 7, 24, 8, 24, 8, 24, 8, 10, 4, 10, 7, 9,
+  8, 9, 3, 12, 8, 23, 10, 22, 10, 22, 10, 22, 10, 23, 8, 12,
+  3, 9, 8, 9, 7, 10, 4, 10, 8, 24, 8, 24, 8, 24, 7, 26,
+  6, 26, 6, 26, 7, 24, 9, 3, 4, 8, 4, 3, 18, 6, 26, 6,
+  26, 6, 13
+};
+
+// 'pawn', 16x16px, 33 runs
+const uint8_t rle_icon_pawn[] PROGMEM = {
+  16, 16,
+  5, 5, 10, 7, 9, 7, 9, 7, 9, 7, 10, 5, 12, 3, 13, 3,
+  11, 7, 9, 7, 8, 9, 7, 9, 6, 11, 4, 13, 3, 13, 2, 15,
+  1
+};
+
+#endif // _ChessClockIcons_H_
@@ -0,0 +1,465 @@
+/*!
+   @file ClockEngine.cpp
+
+   This is part of the Arduino UNO TFT Chess Clock
+   Time keeping of both players, independent of the display and the hardware
+
+
+   Written by Enrique Albertos, with
+   contributions from the open source community.
+
+   Public Domain
+
+*/
+
+#include "ClockEngine.h"
+
+/*!
+   @brief Create a stopped engine
+   @param now   time source, microseconds
+*/
+ClockEngine::ClockEngine(ClockTimeSource now) : m_now{now} {}
+
+/*!
+   @brief    Handler called when the displayed time of the player on move changes
+   @param handler   event handler, nullptr for none
+*/
+void ClockEngine::setDisplayChangedHandler(ClockEventHandler handler) {
+  m_displayChanged = handler;
+}
+
+/*!
+   @brief    Handler called once when the time of the player on move runs out
+   @param handler   event handler, nullptr for none
+*/
+void ClockEngine::setFlagFellHandler(ClockEventHandler handler) {
+  m_flagFell = handler;
+}
+
+/*!
+   @brief    Handler called when the whole seconds of the US delay left change
+   @param handler   event handler, nullptr for none
+*/
+void ClockEngine::setDelayChangedHandler(ClockEventHandler handler) {
+  m_delayChanged = handler;
+}
+
+/*!
+   @brief    Change the step of the displayed time
+   @param micros   step in microseconds
+*/
+void ClockEngine::setDisplayResolution(uint32_t micros) {
+  m_resolution = micros;
+  for (uint8_t i = 0; i < 2; i++) {
+    m_players[i].nextBoundary = boundaryBelow(m_players[i].remaining);
+  }
+}
+
+/*!
+   @brief    Use a finer step of the displayed time at or below a remaining time
+   @param threshold   remaining time the fine step starts at, 0 to disable
+   @param micros      fine step in microseconds
+*/
+void ClockEngine::setLowTimeResolution(ClockMicros threshold, uint32_t micros) {
+  m_lowTime = threshold;
+  m_lowTimeResolution = micros;
+  for (uint8_t i = 0; i < 2; i++) {
+    m_players[i].nextBoundary = boundaryBelow(m_players[i].remaining);
+  }
+}
+
+/*!
+   @brief    Stop the clocks and load a new time control
+   @param game   time control
+*/
+void ClockEngine::reset(const GameType& game) {
+  m_game = game;
+  for (uint8_t i = 0; i < 2; i++) {
+    PlayerClock& player = m_players[i];
+    player.remaining = (ClockMicros)m_game.stages[0].duration * MICROS_IN_SECOND;
+    player.nextBoundary = boundaryBelow(player.remaining);
+    player.moves = 0;
+    player.stageMoves = 0;
+    player.stage = 0;
+  }
+  m_onMove = WHITES;
+  m_running = false;
+  m_flagFallen = false;
+  m_delayLeft = 0;
+  m_delayBoundary = 0;
+  m_turnSpent = 0;
+  m_turnCharged = 0;
+}
+
+/*!
+   @brief    Start the clock of the first player to move
+   @param player   player on move
+*/
+void ClockEngine::start(Player player) {
+  start(player, m_now());
+}
+
+/*!
+   @brief    Start the clock of the first player to move
+   @param player   player on move
+   @param at       time source reading the clock starts from
+*/
+void ClockEngine::start(Player player, uint32_t at) {
+  m_onMove = player;
+  m_running = true;
+  m_last = at;
+  beginTurn();
+}
+
+/*!
+   @brief    End the turn of the player on move and start the other clock
+*/
+void ClockEngine::switchTurn() {
+  switchTurn(m_now());
+}
+
+/*!
+   @brief    End the turn of the player on move at the given time and start the other clock
+   @param at   time source reading of the move
+*/
+void ClockEngine::switchTurn(uint32_t at) {
+  recall(at);
+  advance(at);
+  if (!m_running) {
+    return;
+  }
+  PlayerClock& player = m_players[m_onMove];
+  ++player.moves;
+  ++player.stageMoves;
+
+  const ClockMicros increment = (ClockMicros)m_game.incrementSeconds * MICROS_IN_SECOND;
+  if (m_game.incrementType == FISCHER) {
+    player.remaining += increment;
+  } else if (m_game.incrementType == BRONSTEIN && m_turnSpent < increment) {
+    // the increment was credited when the turn began, take back the unused part
+    player.remaining -= increment - m_turnSpent;
+  }
+
+  const StageType& stage = m_game.stages[player.stage];
+  if (stage.moves > 0 && player.stageMoves >= stage.moves && player.stage + 1 < m_game.stagesNumber) {
+    ++player.stage;
+    player.stageMoves = 0;
+    player.remaining += (ClockMicros)m_game.stages[player.stage].duration * MICROS_IN_SECOND;
+  }
+  player.nextBoundary = boundaryBelow(player.remaining);
+
+  m_onMove = m_onMove == WHITES ? BLACKS : WHITES;
+  beginTurn();
+}
+
+/*!
+   @brief    Stop the running clock, time is accounted up to now
+*/
+void ClockEngine::pause() {
+  pause(m_now());
+}
+
+/*!
+   @brief    Stop the running clock, time is accounted up to the given time
+   @param at   time source reading of the pause
+*/
+void ClockEngine::pause(uint32_t at) {
+  recall(at);
+  advance(at);
+  m_running = false;
+}
+
+/*!
+   @brief    Restart the clock stopped by pause()
+*/
+void ClockEngine::resume() {
+  resume(m_now());
+}
+
+/*!
+   @brief    Restart the clock stopped by pause() from the given time
+   @param at   time source reading the clock restarts from
+*/
+void ClockEngine::resume(uint32_t at) {
+  if (m_flagFallen) {
+    return;
+  }
+  m_last = at;
+  m_running = true;
+}
+
+/*!
+   @brief    Account the time elapsed since the last call and fire the events
+*/
+void ClockEngine::update() {
+  advance(m_now());
+}
+
+/*!
+   @brief    Account the time up to a time source reading and fire the events
+   @param at   time source reading, before the last one rewinds the clock to it
+*/
+void ClockEngine::advance(uint32_t at) {
+  if (!m_running) {
+    return;
+  }
+  const int32_t delta = (int32_t)(at - m_last);
+  m_last = at;
+  if (delta < 0) {
+    rewind(-(ClockMicros)delta);
+    return;
+  }
+  ClockMicros elapsed = delta;
+  m_turnSpent += elapsed;
+
+  if (m_delayLeft > 0) {
+    if (elapsed < m_delayLeft) {
+      m_delayLeft -= elapsed;
+      if (m_delayLeft <= m_delayBoundary) {
+        m_eventAt = at - (uint32_t)(m_delayBoundary - m_delayLeft);
+        m_delayBoundary = secondBelow(m_delayLeft);
+        if (m_delayChanged) {
+          m_delayChanged(m_onMove, m_delayLeft);
+        }
+      }
+      return;
+    }
+    elapsed -= m_delayLeft;
+    m_eventAt = at - (uint32_t)elapsed;
+    m_delayLeft = 0;
+    m_delayBoundary = 0;
+    if (m_delayChanged) {
+      m_delayChanged(m_onMove, 0);
+    }
+  }
+
+  PlayerClock& player = m_players[m_onMove];
+  player.remaining -= elapsed;
+  m_turnCharged += elapsed;
+  if (player.remaining > player.nextBoundary) {
+    return;
+  }
+  m_eventAt = at - (uint32_t)(player.nextBoundary - player.remaining);
+
+  if (player.remaining <= 0) {
+    // the clock stops at the fall, the time past it is not charged
+    m_turnSpent += player.remaining;
+    m_turnCharged += player.remaining;
+    m_last = at - (uint32_t)(-player.remaining);
+    player.remaining = 0;
+    player.nextBoundary = 0;
+    m_running = false;
+    m_flagFallen = true;
+    if (m_flagFell) {
+      m_flagFell(m_onMove, 0);
+    }
+    return;
+  }
+  player.nextBoundary = boundaryAfter(player.nextBoundary, player.remaining);
+  if (m_displayChanged) {
+    m_displayChanged(m_onMove, player.remaining);
+  }
+}
+
+/*!
+   @brief    Take back a flag fall that came after a move or pause, the touch reading
+             of the press may complete after update() has seen the fall
+   @param at   time source reading of the move or pause
+*/
+void ClockEngine::recall(uint32_t at) {
+  if (isFlagFallenAfter(at)) {
+    m_flagFallen = false;
+    m_running = true;
+  }
+}
+
+/*!
+   @brief    When update() has something to report next
+   @param at   set to the time source reading of the event
+   @returns false while no clock runs
+*/
+boolean ClockEngine::nextEventTime(uint32_t& at) const {
+  if (!m_running) {
+    return false;
+  }
+  ClockMicros left = m_delayLeft - m_delayBoundary;
+  if (m_delayLeft == 0) {
+    const PlayerClock& player = m_players[m_onMove];
+    left = player.remaining > player.nextBoundary ? player.remaining - player.nextBoundary : 0;
+  }
+  at = m_last + (uint32_t)left;
+  return true;
+}
+
+/*!
+   @returns the time source reading the last reported event was due at
+*/
+uint32_t ClockEngine::lastEventTime() const {
+  return m_eventAt;
+}
+
+/*!
+   @brief    Remaining time at which the displayed time of a player changes next
+   @param player   player
+   @returns microseconds, 0 when the next change is the flag fall
+*/
+ClockMicros ClockEngine::nextDisplayChange(Player player) const {
+  return m_players[player].nextBoundary;
+}
+
+/*!
+   @brief    Remaining time of a player
+   @param player   player
+   @returns microseconds, never negative
+*/
+ClockMicros ClockEngine::remaining(Player player) const {
+  return m_players[player].remaining;
+}
+
+/*!
+   @brief    Moves made by a player
+   @param player   player
+   @returns number of moves
+*/
+uint16_t ClockEngine::moves(Player player) const {
+  return m_players[player].moves;
+}
+
+/*!
+   @brief    Current stage of a player
+   @param player   player
+   @returns stage index, 0 for the first one
+*/
+uint8_t ClockEngine::stage(Player player) const {
+  return m_players[player].stage;
+}
+
+/*!
+   @brief    Delay left before the clock of the player on move starts running
+   @returns microseconds, 0 outside the delay period
+*/
+ClockMicros ClockEngine::delayRemaining() const {
+  return m_delayLeft;
+}
+
+/*!
+   @returns the player on move
+*/
+ClockEngine::Player ClockEngine::onMove() const {
+  return m_onMove;
+}
+
+/*!
+   @returns true while a clock is running
+*/
+boolean ClockEngine::isRunning() const {
+  return m_running;
+}
+
+/*!
+   @returns true once a flag has fallen, until the next reset
+*/
+boolean ClockEngine::isFlagFallen() const {
+  return m_flagFallen;
+}
+
+/*!
+   @brief    Check if a flag fell after a time source reading
+   @param at   time source reading
+   @returns true if a flag has fallen later than at
+*/
+boolean ClockEngine::isFlagFallenAfter(uint32_t at) const {
+  return m_flagFallen && (int32_t)(at - m_last) < 0;
+}
+
+/*!
+   @returns the time control loaded by reset()
+*/
+const GameType& ClockEngine::game() const {
+  return m_game;
+}
+
+/*!
+   @brief    Give back time accounted past an event that happened earlier, to the
+             player first and then to the delay, the reverse order it was taken
+   @param micros   time to give back, no more than the current turn
+*/
+void ClockEngine::rewind(ClockMicros micros) {
+  if (micros > m_turnSpent) {
+    micros = m_turnSpent;
+  }
+  const ClockMicros refund = micros < m_turnCharged ? micros : m_turnCharged;
+  PlayerClock& player = m_players[m_onMove];
+  player.remaining += refund;
+  player.nextBoundary = boundaryBelow(player.remaining);
+  m_turnCharged -= refund;
+  m_turnSpent -= micros;
+  m_delayLeft += micros - refund;
+  m_delayBoundary = secondBelow(m_delayLeft);
+}
+
+/*!
+   @brief    Start the turn of the player on move: US delay or Bronstein credit
+*/
+void ClockEngine::beginTurn() {
+  const ClockMicros increment = (ClockMicros)m_game.incrementSeconds * MICROS_IN_SECOND;
+  m_turnSpent = 0;
+  m_turnCharged = 0;
+  m_delayLeft = m_game.incrementType == DELAY ? increment : 0;
+  m_delayBoundary = secondBelow(m_delayLeft);
+  if (m_game.incrementType == BRONSTEIN) {
+    PlayerClock& player = m_players[m_onMove];
+    player.remaining += increment;
+    player.nextBoundary = boundaryBelow(player.remaining);
+  }
+}
+
+/*!
+   @brief    Next remaining time at which the displayed value changes, the
+             displayed value is the remaining time rounded up to the resolution,
+             or to the low time resolution at or below the low time threshold
+   @param remaining   remaining time
+   @returns the largest multiple of the resolution below the remaining time
+*/
+ClockMicros ClockEngine::boundaryBelow(ClockMicros remaining) const {
+  if (remaining <= 0) {
+    return 0;
+  }
+  if (remaining <= m_lowTime) {
+    return (remaining - 1) / m_lowTimeResolution * m_lowTimeResolution;
+  }
+  const ClockMicros boundary = (remaining - 1) / m_resolution * m_resolution;
+  return boundary > m_lowTime ? boundary : m_lowTime;
+}
+
+/*!
+   @brief    Next display boundary once one has been crossed, one step below it
+             unless the remaining time is already past that, so that a display
+             change costs a subtraction instead of a 64 bit division
+   @param crossed     boundary just crossed
+   @param remaining   remaining time, at or below it
+   @returns the largest boundary below the remaining time
+*/
+ClockMicros ClockEngine::boundaryAfter(ClockMicros crossed, ClockMicros remaining) const {
+  ClockMicros next = crossed - (crossed <= m_lowTime ? m_lowTimeResolution : m_resolution);
+  if (crossed > m_lowTime && next < m_lowTime) {
+    next = m_lowTime;
+  }
+  if (next < 0 || remaining <= next) {
+    return boundaryBelow(remaining);
+  }
+  return next;
+}
+
+/*!
+   @brief    Next delay left at which the displayed seconds of the delay change,
+             the delay is shown rounded up to the second
+   @param remaining   delay left
+   @returns the largest multiple of a second below it
+*/
+ClockMicros ClockEngine::secondBelow(ClockMicros remaining) {
+  if (remaining <= 0) {
+    return 0;
+  }
+  return (remaining - 1) / MICROS_IN_SECOND * MICROS_IN_SECOND;
+}
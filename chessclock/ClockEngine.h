@@ -0,0 +1,239 @@
+/*!
+   @file ClockEngine.h
+
+   This is part of the Arduino UNO TFT Chess Clock
+   Time keeping of both players, independent of the display and the hardware
+
+
+   Written by Enrique Albertos, with
+   contributions from the open source community.
+
+   Public Domain
+
+*/
+
+#ifndef _ClockEngine_H_
+#define _ClockEngine_H_
+
+#include "arduino.h"
+#include "GameTypes.h"
+
+#define MICROS_IN_SECOND 1000000L
+
+typedef int64_t ClockMicros;            // signed player time, microseconds
+typedef uint32_t (*ClockTimeSource)();  // free running microseconds, may wrap
+typedef void (*ClockEventHandler)(uint8_t player, ClockMicros remaining);
+
+/*!
+   @brief Keeps the time, moves and stages of both players. The engine is driven by
+          an injected time source and reports through event handlers, the caller
+          decides what to draw. update() only subtracts and compares against the
+          next display boundary, divisions happen once per displayed change.
+*/
+class ClockEngine {
+  public:
+    enum Player { WHITES = 0, BLACKS = 1 };
+
+    /*!
+       @brief Create a stopped engine
+       @param now   time source, microseconds
+    */
+    explicit ClockEngine(ClockTimeSource now);
+
+    /*!
+       @brief    Handler called when the displayed time of the player on move changes
+       @param handler   event handler, nullptr for none
+    */
+    void setDisplayChangedHandler(ClockEventHandler handler);
+
+    /*!
+       @brief    Handler called once when the time of the player on move runs out
+       @param handler   event handler, nullptr for none
+    */
+    void setFlagFellHandler(ClockEventHandler handler);
+
+    /*!
+       @brief    Handler called when the whole seconds of the US delay left change,
+                 with 0 when the delay runs out and the clock starts running
+       @param handler   event handler, nullptr for none
+    */
+    void setDelayChangedHandler(ClockEventHandler handler);
+
+    /*!
+       @brief    Change the step of the displayed time, a display changed event
+                 fires each time the remaining time crosses a multiple of it
+       @param micros   step in microseconds, one second by default
+    */
+    void setDisplayResolution(uint32_t micros);
+
+    /*!
+       @brief    Use a finer step of the displayed time once the remaining time is
+                 at or below a threshold, for a low time display with tenths
+       @param threshold   remaining time the fine step starts at, a multiple of the
+                          display resolution, 0 to disable
+       @param micros      fine step in microseconds
+    */
+    void setLowTimeResolution(ClockMicros threshold, uint32_t micros);
+
+    /*!
+       @brief    Stop the clocks and load a new time control
+       @param game   time control
+    */
+    void reset(const GameType& game);
+
+    /*!
+       @brief    Start the clock of the first player to move
+       @param player   player on move
+       @param at       time source reading the clock starts from, now if omitted
+    */
+    void start(Player player);
+    void start(Player player, uint32_t at);
+
+    /*!
+       @brief    End the turn of the player on move: apply the increment, move to the
+                 next stage when its moves are done, and start the other clock. The
+                 turn ends at the given time, even if update() has already run past
+                 it: the time after it is given back and charged to the other player.
+                 A flag that fell after that time is raised again.
+       @param at   time source reading of the move, now if omitted
+    */
+    void switchTurn();
+    void switchTurn(uint32_t at);
+
+    /*!
+       @brief    Stop the running clock, time is accounted up to the given time. A
+                 flag that fell after that time is raised again.
+       @param at   time source reading of the pause, now if omitted
+    */
+    void pause();
+    void pause(uint32_t at);
+
+    /*!
+       @brief    Restart the clock stopped by pause()
+       @param at   time source reading the clock restarts from, now if omitted
+    */
+    void resume();
+    void resume(uint32_t at);
+
+    /*!
+       @brief    Account the time elapsed since the last call and fire the events.
+                 Call it often, at least once per display resolution.
+    */
+    void update();
+
+    /*!
+       @brief    When update() has something to report next: the next displayed
+                 change, the next second of the delay period or the flag fall
+       @param at   set to the time source reading of the event
+       @returns false while no clock runs
+    */
+    boolean nextEventTime(uint32_t& at) const;
+
+    /*!
+       @returns the time source reading at which the last reported event was
+                due, update() reports it at its own reading, later
+    */
+    uint32_t lastEventTime() const;
+
+    /*!
+       @brief    Remaining time at which the displayed time of a player changes next,
+                 what it will show is known before the change happens
+       @param player   player
+       @returns microseconds, 0 when the next change is the flag fall
+    */
+    ClockMicros nextDisplayChange(Player player) const;
+
+    /*!
+       @brief    Remaining time of a player
+       @param player   player
+       @returns microseconds, never negative
+    */
+    ClockMicros remaining(Player player) const;
+
+    /*!
+       @brief    Moves made by a player
+       @param player   player
+       @returns number of moves
+    */
+    uint16_t moves(Player player) const;
+
+    /*!
+       @brief    Current stage of a player
+       @param player   player
+       @returns stage index, 0 for the first one
+    */
+    uint8_t stage(Player player) const;
+
+    /*!
+       @brief    Delay left before the clock of the player on move starts running
+       @returns microseconds, 0 outside the delay period
+    */
+    ClockMicros delayRemaining() const;
+
+    /*!
+       @brief    Player whose clock runs or would run
+       @returns the player on move
+    */
+    Player onMove() const;
+
+    /*!
+       @returns true while a clock is running
+    */
+    boolean isRunning() const;
+
+    /*!
+       @returns true once a flag has fallen, until the next reset
+    */
+    boolean isFlagFallen() const;
+
+    /*!
+       @brief    Check if a flag fell after a time source reading, a move or pause
+                 stamped with it still counts and takes the fall back
+       @param at   time source reading
+       @returns true if a flag has fallen later than at
+    */
+    boolean isFlagFallenAfter(uint32_t at) const;
+
+    /*!
+       @returns the time control loaded by reset()
+    */
+    const GameType& game() const;
+
+  private:
+    struct PlayerClock {
+      ClockMicros remaining;
+      ClockMicros nextBoundary;  // remaining time at which the displayed value changes
+      uint16_t moves;
+      uint16_t stageMoves;       // moves made in the current stage
+      uint8_t stage;
+    };
+
+    ClockTimeSource m_now;
+    ClockEventHandler m_displayChanged{};
+    ClockEventHandler m_flagFell{};
+    ClockEventHandler m_delayChanged{};
+    uint32_t m_resolution{MICROS_IN_SECOND};
+    ClockMicros m_lowTime{};      // remaining time the low time resolution starts at
+    uint32_t m_lowTimeResolution{MICROS_IN_SECOND};
+    uint32_t m_last{};            // time source reading of the last update, of the fall once a flag falls
+    uint32_t m_eventAt{};         // time source reading the last event was due at
+    GameType m_game{};
+    PlayerClock m_players[2]{};
+    Player m_onMove{WHITES};
+    boolean m_running{};
+    boolean m_flagFallen{};
+    ClockMicros m_delayLeft{};    // US delay left in the current turn
+    ClockMicros m_delayBoundary{}; // delay left at which its displayed seconds change
+    ClockMicros m_turnSpent{};    // time used in the current turn, for Bronstein
+    ClockMicros m_turnCharged{};  // part of it taken from the player, after the delay
+
+    void advance(uint32_t at);
+    void recall(uint32_t at);
+    void rewind(ClockMicros micros);
+    void beginTurn();
+    ClockMicros boundaryBelow(ClockMicros remaining) const;
+    ClockMicros boundaryAfter(ClockMicros crossed, ClockMicros remaining) const;
+    static ClockMicros secondBelow(ClockMicros remaining);
+};
+
+#endif // _ClockEngine_H_
@@ -0,0 +1,86 @@
+/*!
+   @file GameTypes.h
+
+   This is part of the Arduino UNO TFT Chess Clock
+   Time control descriptions shared by the sketch and the clock engine
+
+
+   Written by Enrique Albertos, with
+   contributions from the open source community.
+
+   Public Domain
+
+*/
+
+#ifndef _GameTypes_H_
+#define _GameTypes_H_
+
+#include "arduino.h"
+#include "TFTPROGMEMData.h"
+
+enum IncrementType { DELAY = 0, // Delay the player's clock starts after the delay period
+                     BRONSTEIN, // Players receive the used portion of the increment at the end of each turn
+                     FISCHER    // Players receive the full increment at the end of each turn, with increment 0 is BLIZT or GUILLOTINE
+                   };
+
+/** One period of a time control */
+struct StageType {
+  long duration;  // seconds
+  int moves;      // moves to play in the period, 0 for the rest of the game
+};
+
+/** Time control, up to three periods */
+struct GameType {
+  IncrementType incrementType;
+  uint16_t incrementSeconds;
+  uint16_t stagesNumber;
+  StageType stages[3];
+};
+
+/** A period of a time control kept in PROGMEM, its fields are read on demand */
+class StageTypeView {
+  public:
+    explicit StageTypeView(const StageType* stage) : m_stage(stage) {}
+
+    long duration() const {
+      return PROGMEMField(&m_stage->duration);
+    }
+
+    int moves() const {
+      return PROGMEMField(&m_stage->moves);
+    }
+
+  private:
+    const StageType* m_stage;
+};
+
+/*!
+   @brief A time control kept in PROGMEM. It is the size of a pointer and is
+          passed by value, its fields are read on demand instead of copying
+          the whole GameType to the stack.
+*/
+class GameTypeView {
+  public:
+    explicit GameTypeView(const GameType* game) : m_game(game) {}
+
+    IncrementType incrementType() const {
+      return PROGMEMField(&m_game->incrementType);
+    }
+
+    uint16_t incrementSeconds() const {
+      return PROGMEMField(&m_game->incrementSeconds);
+    }
+
+    uint16_t stagesNumber() const {
+      return PROGMEMField(&m_game->stagesNumber);
+    }
+
+    StageTypeView stage(uint8_t k) const {
+      return StageTypeView(&m_game->stages[k]);
+    }
+
+  private:
+    const GameType* m_game;
+};
+
+#endif // _GameTypes_H_
@@ -0,0 +1,61 @@
+/*!
+   @file LatencyHistogram.cpp
+
+   This is part of the Arduino UNO TFT Chess Clock
+   Histogram of short latencies, in 256 us buckets
+
+
+   Written by Enrique Albertos, with
+   contributions from the open source community.
+
+   Public Domain
+
+*/
+
+#include "LatencyHistogram.h"
+
+/*!
+   @brief    Count one latency
+   @param micros   latency in microseconds
+*/
+void LatencyHistogram::record(uint32_t micros) {
+  const uint32_t i = micros >> LATENCY_BUCKET_SHIFT;
+  uint16_t& bucket = m_buckets[i < LATENCY_BUCKETS ? i : LATENCY_BUCKETS - 1];
+  if (bucket < 0xFFFF) {
+    ++bucket;
+  }
+  ++m_count;
+  if (micros > m_maxMicros) {
+    m_maxMicros = micros;
+  }
+}
+
+/*!
+   @brief    Forget every latency counted
+*/
+void LatencyHistogram::reset() {
+  *this = LatencyHistogram{};
+}
+
+/*!
+   @brief    Latencies counted in a bucket
+   @param i   bucket, from 0 to LATENCY_BUCKETS - 1
+   @returns the count, it saturates
+*/
+uint16_t LatencyHistogram::bucket(uint8_t i) const {
+  return m_buckets[i];
+}
+
+/*!
+   @returns latencies counted since the last reset
+*/
+uint32_t LatencyHistogram::count() const {
+  return m_count;
+}
+
+/*!
+   @returns the longest latency counted, microseconds
+*/
+uint32_t LatencyHistogram::maxMicros() const {
+  return m_maxMicros;
+}
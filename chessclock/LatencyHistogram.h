@@ -0,0 +1,63 @@
+/*!
+   @file LatencyHistogram.h
+
+   This is part of the Arduino UNO TFT Chess Clock
+   Histogram of short latencies, in 256 us buckets
+
+
+   Written by Enrique Albertos, with
+   contributions from the open source community.
+
+   Public Domain
+
+*/
+
+#ifndef _LatencyHistogram_H_
+#define _LatencyHistogram_H_
+
+#include "arduino.h"
+
+#define LATENCY_BUCKETS 16      // the last one also counts everything longer
+#define LATENCY_BUCKET_SHIFT 8  // 256 us per bucket, 4 ms in range
+
+/*!
+   @brief Counts latencies into fixed width buckets with a shift, no division on
+          the recording path, and keeps the worst one.
+*/
+class LatencyHistogram {
+  public:
+    /*!
+       @brief    Count one latency
+       @param micros   latency in microseconds
+    */
+    void record(uint32_t micros);
+
+    /*!
+       @brief    Forget every latency counted
+    */
+    void reset();
+
+    /*!
+       @brief    Latencies counted in a bucket
+       @param i   bucket, from 0 to LATENCY_BUCKETS - 1
+       @returns the count, it saturates
+    */
+    uint16_t bucket(uint8_t i) const;
+
+    /*!
+       @returns latencies counted since the last reset
+    */
+    uint32_t count() const;
+
+    /*!
+       @returns the longest latency counted, microseconds
+    */
+    uint32_t maxMicros() const;
+
+  private:
+    uint16_t m_buckets[LATENCY_BUCKETS]{};
+    uint32_t m_count{};
+    uint32_t m_maxMicros{};
+};
+
+#endif // _LatencyHistogram_H_
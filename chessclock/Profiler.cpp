@@ -0,0 +1,110 @@
+/*!
+   @file Profiler.cpp
+
+   This is part of the Arduino UNO TFT Chess Clock
+   Where the loop time goes, duration histograms of the main code sections
+
+
+   Written by Enrique Albertos, with
+   contributions from the open source community.
+
+   Public Domain
+
+*/
+
+#include "Profiler.h"
+
+#if defined(CHESSCLOCK_PROFILE)
+
+static const char profileUiName[] PROGMEM = "ui";
+static const char profileClockName[] PROGMEM = "clock";
+static const char profilePrintTimeName[] PROGMEM = "printTime";
+static const char profilePrintPauseTimeName[] PROGMEM = "printPauseTime";
+static const char profileSettingsName[] PROGMEM = "paintSettings";
+static const char profileModuleDrawName[] PROGMEM = "moduleDraw";
+
+static const char* const profileNames[PROFILE_SECTIONS] PROGMEM = {
+  profileUiName, profileClockName, profilePrintTimeName, profilePrintPauseTimeName,
+  profileSettingsName, profileModuleDrawName
+};
+
+ProfileHistogram Profiler::s_histograms[PROFILE_SECTIONS];
+
+/*!
+   @brief    Count one run of a section
+   @param section   section measured
+   @param micros    its duration in microseconds
+*/
+void Profiler::record(ProfileSection section, uint32_t micros) {
+  ProfileHistogram& histogram = s_histograms[section];
+  uint8_t i = 0;
+  for (uint32_t limit = micros >> PROFILE_FIRST_BUCKET_SHIFT; limit && i < PROFILE_BUCKETS - 1; limit >>= 1) {
+    ++i;
+  }
+  if (histogram.buckets[i] < 0xFFFF) {
+    ++histogram.buckets[i];
+  }
+  ++histogram.count;
+  histogram.totalMicros += micros;
+  if (micros > histogram.maxMicros) {
+    histogram.maxMicros = micros;
+  }
+}
+
+/*!
+   @brief    Forget every run counted
+*/
+void Profiler::reset() {
+  for (uint8_t i = 0; i < PROFILE_SECTIONS; i++) {
+    s_histograms[i] = ProfileHistogram{};
+  }
+}
+
+/*!
+   @param section   section measured
+   @returns the runs counted since the last reset
+*/
+const ProfileHistogram& Profiler::histogram(ProfileSection section) {
+  return s_histograms[section];
+}
+
+/*!
+   @brief    Serve the profiler commands waiting on the serial port
+*/
+void Profiler::poll() {
+  while (Serial.available() > 0) {
+    switch (Serial.read()) {
+      case 'p':
+        dump(Serial);
+        break;
+      case 'r':
+        reset();
+        break;
+    }
+  }
+}
+
+/*!
+   @brief    Print a line per section: name, runs, mean, max and bucket counts
+   @param out   where to print
+*/
+void Profiler::dump(Print& out) {
+  for (uint8_t i = 0; i < PROFILE_SECTIONS; i++) {
+    const ProfileHistogram& histogram = s_histograms[i];
+    out.print((const __FlashStringHelper*) pgm_read_ptr(&profileNames[i]));
+    out.print(' ');
+    out.print(histogram.count);
+    out.print(F(" runs, mean "));
+    out.print(histogram.count ? histogram.totalMicros / histogram.count : 0UL);
+    out.print(F(" us, max "));
+    out.print(histogram.maxMicros);
+    out.print(F(" us:"));
+    for (uint8_t j = 0; j < PROFILE_BUCKETS; j++) {
+      out.print(' ');
+      out.print(histogram.buckets[j]);
+    }
+    out.println();
+  }
+}
+
+#endif // CHESSCLOCK_PROFILE
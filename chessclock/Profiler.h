@@ -0,0 +1,117 @@
+/*!
+   @file Profiler.h
+
+   This is part of the Arduino UNO TFT Chess Clock
+   Where the loop time goes, duration histograms of the main code sections
+
+
+   Written by Enrique Albertos, with
+   contributions from the open source community.
+
+   Public Domain
+
+*/
+
+#ifndef _Profiler_H_
+#define _Profiler_H_
+
+#include "arduino.h"
+
+// Uncomment, or define it on the compiler command line, to build the profiler in.
+// Without it PROFILE_SCOPE expands to nothing and nothing else is compiled.
+// #define CHESSCLOCK_PROFILE
+
+#define PROFILE_BUCKETS 12         // the last one also counts everything longer
+#define PROFILE_FIRST_BUCKET_SHIFT 4  // under 16 us, then every bucket doubles, 16 ms and longer last
+
+/** Code sections measured */
+enum ProfileSection {PROFILE_UI, PROFILE_CLOCK, PROFILE_PRINT_TIME, PROFILE_PRINT_PAUSE_TIME,
+                     PROFILE_SETTINGS, PROFILE_MODULE_DRAW, PROFILE_SECTIONS
+                    };
+
+#if defined(CHESSCLOCK_PROFILE)
+
+#define PROFILE_JOIN2(a, b) a##b
+#define PROFILE_JOIN(a, b) PROFILE_JOIN2(a, b)
+#define PROFILE_SCOPE(section) ProfileScope PROFILE_JOIN(profileScope, __LINE__)(section)
+
+/** Durations of one section since the last reset */
+struct ProfileHistogram {
+  uint16_t buckets[PROFILE_BUCKETS]; // saturating counts, bucket i holds durations under 16 << i us
+  uint32_t count;
+  uint32_t totalMicros;              // for the mean
+  uint32_t maxMicros;
+};
+
+/*!
+   @brief Accumulates the duration of each section into a histogram of power of
+          two buckets, a few hundred bytes in all, and prints them on a Serial
+          command. Sections may nest, a section counts the time of the ones inside.
+*/
+class Profiler {
+  public:
+    /*!
+       @brief    Count one run of a section
+       @param section   section measured
+       @param micros    its duration in microseconds
+    */
+    static void record(ProfileSection section, uint32_t micros);
+
+    /*!
+       @brief    Forget every run counted
+    */
+    static void reset();
+
+    /*!
+       @param section   section measured
+       @returns the runs counted since the last reset
+    */
+    static const ProfileHistogram& histogram(ProfileSection section);
+
+    /*!
+       @brief    Serve the profiler commands waiting on the serial port:
+                 'p' prints the histograms, 'r' resets them
+    */
+    static void poll();
+
+    /*!
+       @brief    Print a line per section: name, runs, mean, max and bucket counts
+       @param out   where to print
+    */
+    static void dump(Print& out);
+
+  private:
+    static ProfileHistogram s_histograms[PROFILE_SECTIONS];
+};
+
+/*!
+   @brief Measures its own lifetime into a section
+*/
+class ProfileScope {
+  public:
+    /*!
+       @brief    Start measuring
+       @param section   section the scope belongs to
+    */
+    explicit ProfileScope(ProfileSection section) : m_section{section}, m_start{(uint32_t)micros()} {
+    }
+
+    /*!
+       @brief    Count the time since construction
+    */
+    ~ProfileScope() {
+      Profiler::record(m_section, micros() - m_start);
+    }
+
+  private:
+    ProfileSection m_section;
+    uint32_t m_start;
+};
+
+#else
+
+#define PROFILE_SCOPE(section)
+
+#endif // CHESSCLOCK_PROFILE
+
+#endif // _Profiler_H_
@@ -0,0 +1,121 @@
+/*!
+   @file RenderQueue.cpp
+
+   This is part of the Arduino UNO TFT Chess Clock
+   Splits large repaints into work units run against a time budget per loop
+
+
+   Written by Enrique Albertos, with
+   contributions from the open source community.
+
+   Public Domain
+
+*/
+
+#include "RenderQueue.h"
+
+#define RENDER_QUEUE_MASK (RENDER_QUEUE_SIZE - 1)
+
+/*!
+   @brief    Queue a unit of work, run it at once if the queue is full
+   @param work   function to call
+   @param arg    its argument
+*/
+void RenderQueue::push(RenderWork work, uint16_t arg) {
+  if ((uint8_t)(m_head - m_tail) == RENDER_QUEUE_SIZE) {
+    // keep the order, the oldest unit makes room
+    runNext();
+  }
+  m_units[m_head & RENDER_QUEUE_MASK] = RenderUnit{work, arg};
+  ++m_head;
+}
+
+/*!
+   @brief    Run queued units until the budget of this iteration is spent
+*/
+void RenderQueue::run() {
+  if (isEmpty()) {
+    return;
+  }
+  const uint32_t start = micros();
+  uint32_t elapsed;
+  do {
+    runNext();
+    elapsed = micros() - start;
+  } while (!isEmpty() && elapsed < m_budget);
+
+  ++m_stats.frames;
+  if (elapsed > m_budget) {
+    ++m_stats.overruns;
+  }
+  if (elapsed > m_stats.maxFrameMicros) {
+    m_stats.maxFrameMicros = elapsed;
+  }
+}
+
+/*!
+   @brief    Run a unit at once if nothing is queued, otherwise queue it behind
+             the pending units
+   @param work   function to call
+   @param arg    its argument
+*/
+void RenderQueue::runOrPush(RenderWork work, uint16_t arg) {
+  if (!isEmpty()) {
+    push(work, arg);
+    return;
+  }
+  work(arg);
+  ++m_stats.units;
+}
+
+/*!
+   @brief    Drop the queued units
+*/
+void RenderQueue::clear() {
+  m_tail = m_head;
+}
+
+/*!
+   @returns true if there is no work queued
+*/
+boolean RenderQueue::isEmpty() const {
+  return m_head == m_tail;
+}
+
+/*!
+   @brief    Change the drawing time per loop iteration
+   @param micros   budget, 0 runs one unit per iteration
+*/
+void RenderQueue::setBudget(uint32_t micros) {
+  m_budget = micros;
+}
+
+/*!
+   @returns the time spent on the queued work since the last reset
+*/
+const RenderStats& RenderQueue::stats() const {
+  return m_stats;
+}
+
+/*!
+   @brief    Clear the work counters
+*/
+void RenderQueue::resetStats() {
+  m_stats = RenderStats{};
+}
+
+/*!
+   @brief    Run the oldest unit, it is taken off the queue first so that it may
+             queue more work
+   @returns false if the queue was empty
+*/
+boolean RenderQueue::runNext() {
+  if (isEmpty()) {
+    return false;
+  }
+  const RenderUnit unit = m_units[m_tail & RENDER_QUEUE_MASK];
+  ++m_tail;
+  unit.work(unit.arg);
+  ++m_stats.units;
+  return true;
+}
@@ -0,0 +1,104 @@
+/*!
+   @file RenderQueue.h
+
+   This is part of the Arduino UNO TFT Chess Clock
+   Splits large repaints into work units run against a time budget per loop
+
+
+   Written by Enrique Albertos, with
+   contributions from the open source community.
+
+   Public Domain
+
+*/
+
+#ifndef _RenderQueue_H_
+#define _RenderQueue_H_
+
+#include "arduino.h"
+
+#define RENDER_QUEUE_SIZE 8             // power of two
+#define RENDER_BUDGET_MICROS 5000L      // drawing time per loop iteration
+
+/** A bounded piece of a repaint: a screen clear, a row of cells, an icon */
+typedef void (*RenderWork)(uint16_t arg);
+
+/** Time spent on the queued work since the last reset */
+struct RenderStats {
+  uint32_t units;            // work units run
+  uint32_t frames;           // loop iterations that ran work
+  uint32_t overruns;         // frames that took longer than the budget
+  uint32_t maxFrameMicros;   // longest frame
+};
+
+/*!
+   @brief Cooperative queue of repaint work. The loop serves the clock and the
+          touch panel first and then runs queued units until the budget of the
+          iteration is spent, a unit is never interrupted, so a frame runs at
+          least one unit and overruns when a unit is longer than the budget.
+          Units run in the order they were queued.
+*/
+class RenderQueue {
+  public:
+    /*!
+       @brief    Queue a unit of work, run it at once if the queue is full
+       @param work   function to call
+       @param arg    its argument
+    */
+    void push(RenderWork work, uint16_t arg);
+
+    /*!
+       @brief    Run queued units until the budget of this iteration is spent
+    */
+    void run();
+
+    /*!
+       @brief    Run a unit at once if nothing is queued, otherwise queue it behind
+                 the pending units, for paints over the screen as the queue leaves it
+       @param work   function to call
+       @param arg    its argument
+    */
+    void runOrPush(RenderWork work, uint16_t arg);
+
+    /*!
+       @brief    Drop the queued units, the screen they would paint is gone
+    */
+    void clear();
+
+    /*!
+       @returns true if there is no work queued
+    */
+    boolean isEmpty() const;
+
+    /*!
+       @brief    Change the drawing time per loop iteration
+       @param micros   budget, 0 runs one unit per iteration
+    */
+    void setBudget(uint32_t micros);
+
+    /*!
+       @returns the time spent on the queued work since the last reset
+    */
+    const RenderStats& stats() const;
+
+    /*!
+       @brief    Clear the work counters
+    */
+    void resetStats();
+
+  private:
+    struct RenderUnit {
+      RenderWork work;
+      uint16_t arg;
+    };
+
+    RenderUnit m_units[RENDER_QUEUE_SIZE];
+    uint8_t m_head{};  // next slot to write
+    uint8_t m_tail{};  // next slot to run
+    uint32_t m_budget{RENDER_BUDGET_MICROS};
+    RenderStats m_stats{};
+
+    boolean runNext();
+};
+
+#endif // _RenderQueue_H_
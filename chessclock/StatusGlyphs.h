@@ -0,0 +1,72 @@
+/*!
+   @file StatusGlyphs.h
+
+   This is part of the Arduino UNO TFT Chess Clock
+   Glyphs of the status labels compiled into vertical runs for TFTSpanLabel,
+   generated by host/glyph_spans, do not edit
+
+
+   Written by Enrique Albertos, with
+   contributions from the open source community.
+
+   Public Domain
+
+*/
+
+#ifndef _StatusGlyphs_H_
+#define _StatusGlyphs_H_
+
+#include "arduino.h"
+
+#define STATUS_GLYPHS 35
+
+// compiled characters, sorted
+const char statusGlyphChars[STATUS_GLYPHS + 1] PROGMEM = " /0123456789ABCDEFGHILMNOPRSTUXYmsv";
+
+// first run of each glyph, the last entry ends the last glyph
+const uint16_t statusGlyphOffsets[STATUS_GLYPHS + 1] PROGMEM = {
+  0, 0, 9, 24, 31, 48, 64, 75, 92, 108, 121, 138, 154, 166, 182, 195,
+  207, 223, 235, 249, 258, 266, 275, 284, 293, 305, 317, 331, 348, 357, 366, 379,
+  388, 397, 414, 423
+};
+
+// start row << 4 | length, 0 moves to the next column
+const uint8_t statusGlyphRuns[] PROGMEM = {
+  // ' '
+  0x51, 0x00, 0x41, 0x00, 0x31, 0x00, 0x21, 0x00, 0x11, // '/'
+  0x15, 0x00, 0x01, 0x41, 0x61, 0x00, 0x01, 0x31, 0x61, 0x00, 0x01, 0x21, 0x61, 0x00, 0x15, // '0'
+  0x00, 0x11, 0x61, 0x00, 0x07, 0x00, 0x61, // '1'
+  0x11, 0x43, 0x00, 0x01, 0x31, 0x61, 0x00, 0x01, 0x31, 0x61, 0x00, 0x01, 0x31, 0x61, 0x00, 0x12, 0x61, // '2'
+  0x01, 0x51, 0x00, 0x01, 0x61, 0x00, 0x01, 0x31, 0x61, 0x00, 0x01, 0x22, 0x61, 0x00, 0x02, 0x42, // '3'
+  0x32, 0x00, 0x21, 0x41, 0x00, 0x11, 0x41, 0x00, 0x07, 0x00, 0x41, // '4'
+  0x03, 0x51, 0x00, 0x01, 0x21, 0x61, 0x00, 0x01, 0x21, 0x61, 0x00, 0x01, 0x21, 0x61, 0x00, 0x01, 0x33, // '5'
+  0x24, 0x00, 0x11, 0x31, 0x61, 0x00, 0x01, 0x31, 0x61, 0x00, 0x01, 0x31, 0x61, 0x00, 0x01, 0x42, // '6'
+  0x01, 0x61, 0x00, 0x01, 0x51, 0x00, 0x01, 0x41, 0x00, 0x01, 0x31, 0x00, 0x03, // '7'
+  0x12, 0x42, 0x00, 0x01, 0x31, 0x61, 0x00, 0x01, 0x31, 0x61, 0x00, 0x01, 0x31, 0x61, 0x00, 0x12, 0x42, // '8'
+  0x12, 0x61, 0x00, 0x01, 0x31, 0x61, 0x00, 0x01, 0x31, 0x61, 0x00, 0x01, 0x31, 0x51, 0x00, 0x14, // '9'
+  0x25, 0x00, 0x11, 0x41, 0x00, 0x01, 0x41, 0x00, 0x11, 0x41, 0x00, 0x25, // 'A'
+  0x07, 0x00, 0x01, 0x31, 0x61, 0x00, 0x01, 0x31, 0x61, 0x00, 0x01, 0x31, 0x61, 0x00, 0x12, 0x42, // 'B'
+  0x15, 0x00, 0x01, 0x61, 0x00, 0x01, 0x61, 0x00, 0x01, 0x61, 0x00, 0x11, 0x51, // 'C'
+  0x07, 0x00, 0x01, 0x61, 0x00, 0x01, 0x61, 0x00, 0x01, 0x61, 0x00, 0x15, // 'D'
+  0x07, 0x00, 0x01, 0x31, 0x61, 0x00, 0x01, 0x31, 0x61, 0x00, 0x01, 0x31, 0x61, 0x00, 0x01, 0x61, // 'E'
+  0x07, 0x00, 0x01, 0x31, 0x00, 0x01, 0x31, 0x00, 0x01, 0x31, 0x00, 0x01, // 'F'
+  0x15, 0x00, 0x01, 0x61, 0x00, 0x01, 0x61, 0x00, 0x01, 0x41, 0x61, 0x00, 0x02, 0x43, // 'G'
+  0x07, 0x00, 0x31, 0x00, 0x31, 0x00, 0x31, 0x00, 0x07, // 'H'
+  0x00, 0x01, 0x61, 0x00, 0x07, 0x00, 0x01, 0x61, // 'I'
+  0x07, 0x00, 0x61, 0x00, 0x61, 0x00, 0x61, 0x00, 0x61, // 'L'
+  0x07, 0x00, 0x11, 0x00, 0x23, 0x00, 0x11, 0x00, 0x07, // 'M'
+  0x07, 0x00, 0x21, 0x00, 0x31, 0x00, 0x41, 0x00, 0x07, // 'N'
+  0x15, 0x00, 0x01, 0x61, 0x00, 0x01, 0x61, 0x00, 0x01, 0x61, 0x00, 0x15, // 'O'
+  0x07, 0x00, 0x01, 0x31, 0x00, 0x01, 0x31, 0x00, 0x01, 0x31, 0x00, 0x12, // 'P'
+  0x07, 0x00, 0x01, 0x31, 0x00, 0x01, 0x32, 0x00, 0x01, 0x31, 0x51, 0x00, 0x12, 0x61, // 'R'
+  0x12, 0x51, 0x00, 0x01, 0x31, 0x61, 0x00, 0x01, 0x31, 0x61, 0x00, 0x01, 0x31, 0x61, 0x00, 0x11, 0x42, // 'S'
+  0x02, 0x00, 0x01, 0x00, 0x07, 0x00, 0x01, 0x00, 0x02, // 'T'
+  0x06, 0x00, 0x61, 0x00, 0x61, 0x00, 0x61, 0x00, 0x06, // 'U'
+  0x02, 0x52, 0x00, 0x21, 0x41, 0x00, 0x31, 0x00, 0x21, 0x41, 0x00, 0x02, 0x52, // 'X'
+  0x02, 0x00, 0x21, 0x00, 0x34, 0x00, 0x21, 0x00, 0x02, // 'Y'
+  0x25, 0x00, 0x21, 0x00, 0x34, 0x00, 0x21, 0x00, 0x34, // 'm'
+  0x31, 0x61, 0x00, 0x21, 0x41, 0x61, 0x00, 0x21, 0x41, 0x61, 0x00, 0x21, 0x41, 0x61, 0x00, 0x21, 0x51, // 's'
+  0x23, 0x00, 0x51, 0x00, 0x61, 0x00, 0x51, 0x00, 0x23, // 'v'
+};
+
+#endif // _StatusGlyphs_H_
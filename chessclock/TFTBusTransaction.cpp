@@ -0,0 +1,74 @@
+/*!
+   @file TFTBusTransaction.cpp
+
+   This is part of the TFT Virtual Segment Display for Arduino
+   Groups TFT writes into bus transactions and counts them
+
+
+   Written by Enrique Albertos, with
+   contributions from the open source community.
+
+   Public Domain
+
+*/
+
+#include "TFTBusTransaction.h"
+
+uint8_t TFTBusTransaction::s_depth = 0;
+uint32_t TFTBusTransaction::s_count = 0;
+void (*TFTBusTransaction::s_acquireHook)() = nullptr;
+
+/*!
+   @brief    Open a transaction, selects the tft if none is open
+   @param tft   pointer to Adafruit_TFTLCD
+*/
+void TFTBusTransaction::begin(Adafruit_TFTLCD* tft) {
+  if (s_depth++ == 0) {
+    if (s_acquireHook) {
+      s_acquireHook();
+    }
+    tft->startWrite();
+    ++s_count;
+  }
+}
+
+/*!
+   @brief    Close a transaction, releases the tft when the outermost one ends
+   @param tft   pointer to Adafruit_TFTLCD
+*/
+void TFTBusTransaction::end(Adafruit_TFTLCD* tft) {
+  if (s_depth > 0 && --s_depth == 0) {
+    tft->endWrite();
+  }
+}
+
+/*!
+   @brief    Check if a transaction is open
+   @returns true while the bus is taken
+*/
+boolean TFTBusTransaction::isOpen() {
+  return s_depth > 0;
+}
+
+/*!
+   @brief    Number of startWrite/endWrite pairs issued since the last reset
+   @returns the transaction count
+*/
+uint32_t TFTBusTransaction::count() {
+  return s_count;
+}
+
+/*!
+   @brief    Reset the transaction counter
+*/
+void TFTBusTransaction::resetCount() {
+  s_count = 0;
+}
+
+/*!
+   @brief    Function called before the outermost transaction takes the bus
+   @param hook   function to call, nullptr for none
+*/
+void TFTBusTransaction::setAcquireHook(void (*hook)()) {
+  s_acquireHook = hook;
+}
@@ -0,0 +1,69 @@
+/*!
+   @file TFTBusTransaction.h
+
+   This is part of the TFT Virtual Segment Display for Arduino
+   Groups TFT writes into bus transactions and counts them
+
+
+   Written by Enrique Albertos, with
+   contributions from the open source community.
+
+   Public Domain
+
+*/
+
+#ifndef _TFTBusTransaction_H_
+#define _TFTBusTransaction_H_
+
+#include "arduino.h"
+#include <Adafruit_TFTLCD.h> // Hardware-specific library
+
+/*!
+   @brief Nestable bus transaction. Only the outermost begin/end pair calls
+          startWrite/endWrite on the tft, inner pairs just write.
+*/
+class TFTBusTransaction {
+  public:
+    /*!
+      @brief    Open a transaction, selects the tft if none is open
+      @param tft   pointer to Adafruit_TFTLCD
+    */
+    static void begin(Adafruit_TFTLCD* );
+
+    /*!
+      @brief    Close a transaction, releases the tft when the outermost one ends
+      @param tft   pointer to Adafruit_TFTLCD
+    */
+    static void end(Adafruit_TFTLCD* );
+
+    /*!
+      @brief    Check if a transaction is open
+      @returns true while the bus is taken
+    */
+    static boolean isOpen();
+
+    /*!
+      @brief    Number of startWrite/endWrite pairs issued since the last reset
+      @returns the transaction count
+    */
+    static uint32_t count();
+
+    /*!
+      @brief    Reset the transaction counter
+    */
+    static void resetCount();
+
+    /*!
+      @brief    Function called before the outermost transaction takes the bus, lets
+                other users of the shared pins finish and hand them back
+      @param hook   function to call, nullptr for none
+    */
+    static void setAcquireHook(void (*)());
+
+  private:
+    static uint8_t s_depth;
+    static uint32_t s_count;
+    static void (*s_acquireHook)();
+};
+
+#endif // _TFTBusTransaction_H_
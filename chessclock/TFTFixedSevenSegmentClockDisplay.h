@@ -0,0 +1,179 @@
+/*!
+   @file TFTFixedSevenSegmentClockDisplay.h
+
+   This is part of the TFT Virtual Segment Display for Arduino
+   Virtual seven segments clock display for Arduino TFT LCD Displays
+   Clock with 4 or 6 seven segment modules, geometry fixed at compile time
+
+
+   Written by Enrique Albertos, with
+   contributions from the open source community.
+
+   Public Domain
+
+*/
+
+#ifndef _TFTFixedSevenSegmentClockDisplay_H_
+#define _TFTFixedSevenSegmentClockDisplay_H_
+
+#include "arduino.h"
+#include <Adafruit_TFTLCD.h> // Hardware-specific library
+#include "TFTSevenSegmentClock.h"
+#include "TFTFixedSevenSegmentModule.h"
+
+/*!
+   @brief Clock display laid out by the compiler. Same layout as
+          TFTSevenSegmentClockDisplay, with the seconds reduction factor given as
+          the fraction RATIO_NUM / RATIO_DEN instead of a float.
+          @param W           seven segment module width
+          @param H           seven segment module height
+          @param LED         width in pixels of each segment led
+          @param SHOW_HOURS  true show clock with hours-minutes-seconds, false show only minutes-seconds
+          @param RATIO_NUM   numerator of the seconds reduction factor
+          @param RATIO_DEN   denominator of the seconds reduction factor
+*/
+template <int16_t W, int16_t H, int16_t LED, bool SHOW_HOURS, int16_t RATIO_NUM, int16_t RATIO_DEN>
+class TFTFixedSevenSegmentClockDisplay : public TFTSevenSegmentClock {
+
+  public:
+    static const int16_t SECONDS_W = W * RATIO_NUM / RATIO_DEN;
+    static const int16_t SECONDS_H = H * RATIO_NUM / RATIO_DEN;
+    static const int16_t SECONDS_LED = LED > 2 ? LED * RATIO_NUM / RATIO_DEN + 1 : LED;
+
+    typedef TFTFixedSevenSegmentModule<W, H, LED> Module;
+    typedef TFTFixedSevenSegmentModule<SECONDS_W, SECONDS_H, SECONDS_LED> SecondsModule;
+
+    /*!
+      @brief Create a TFTFixedSevenSegmentClockDisplay
+         @param tft                pointer to Adafruit_TFTLCD
+         @param x                  x coordinate
+         @param y                  y coordinate
+         @param onColor            565 segment color when led segments are in on state
+         @param offColor           565 segment color when led segment are in off state
+    */
+    TFTFixedSevenSegmentClockDisplay(Adafruit_TFTLCD* tft, int16_t x, int16_t y, uint16_t onColor, uint16_t offColor) :
+      TFTSevenSegmentClock(tft, x, y, W, H, onColor, offColor, LED, SHOW_HOURS)
+    {
+      for (uint8_t i = 0; i < MODULES; i++) {
+        m_digits[i] = Module(tft, x + offsetX(FIRST + i), y, onColor, offColor);
+      }
+      for (uint8_t i = 0; i < 2; i++) {
+        m_seconds[i] = SecondsModule(tft, x + offsetX(SS1 + i), y, onColor, offColor);
+      }
+      if (SHOW_HOURS) {
+        layoutSeparators(x + offsetX(HH2) + W, x + offsetX(MM1), x + offsetX(MM2) + W, x + offsetX(SS1),
+                         H, SECONDS_H, LED);
+      }
+      layoutDecimalPoint(x + offsetX(MM2) + W + (offsetX(SS1) - offsetX(MM2) - W - LED) / 2, y + H - LED, LED);
+    }
+
+    /*!
+       @brief    Change next onColor of the led segments
+          @param color   565 segment color when led segments are in on state
+    */
+    void setOnColor(uint16_t color) override {
+      for (uint8_t i = 0; i < MODULES; i++) {
+        m_digits[i].setOnColor(color);
+      }
+      for (uint8_t i = 0; i < 2; i++) {
+        m_seconds[i].setOnColor(color);
+      }
+      m_onColor = color;
+    }
+
+    /*!
+      @brief    Change next offColor of the led segments
+      @param color   565 segment color when led segments are in off state
+    */
+    void setOffColor(uint16_t color) override {
+      for (uint8_t i = 0; i < MODULES; i++) {
+        m_digits[i].setOffColor(color);
+      }
+      for (uint8_t i = 0; i < 2; i++) {
+        m_seconds[i].setOffColor(color);
+      }
+      m_offColor = color;
+    }
+
+    /*!
+      @brief    Get the current width in pixels
+      @returns the width in pixels
+    */
+    int16_t getWidth() override {
+      return offsetX(SS2) + SECONDS_W - offsetX(FIRST);
+    }
+
+    /*!
+      @brief    Get the current height in pixels
+      @returns the height in pixels
+    */
+    int16_t getHeight() override {
+      return SECONDS_H > H ? SECONDS_H : H;
+    }
+
+    /*!
+      @brief   forget what is on screen, next display call repaints every segment
+    */
+    void invalidate() override {
+      for (uint8_t i = 0; i < MODULES; i++) {
+        m_digits[i].invalidate();
+      }
+      for (uint8_t i = 0; i < 2; i++) {
+        m_seconds[i].invalidate();
+      }
+      TFTSevenSegmentClock::invalidate();
+    }
+
+  protected:
+    /*!
+      @brief    Display one digit on a seven segment module
+      @param unit     module, HH1 to SS2
+      @param digit    digit 0 to 9
+      @param on       true draw the digit, false draw all the segments off
+    */
+    void displayDigit(uint8_t unit, int16_t digit, boolean on) override {
+      if (unit >= SS1) {
+        show(m_seconds[unit - SS1], digit, on);
+      } else {
+        show(m_digits[unit - FIRST], digit, on);
+      }
+    }
+
+  private:
+    static const uint8_t FIRST = SHOW_HOURS ? HH1 : MM1;  // first module on screen
+    static const uint8_t MODULES = SS1 - FIRST;           // full size modules
+    static const int16_t STEP = W + W / 8 + 3;            // distance between full size modules
+    static const int16_t GROUP = W / 2;                   // extra gap after each pair
+
+    Module m_digits[MODULES];       // stored inline, no heap
+    SecondsModule m_seconds[2];
+
+    /*!
+      @brief    x offset of a module from the display origin
+      @param unit     module, HH1 to SS2
+      @returns the offset in pixels
+    */
+    static constexpr int16_t offsetX(uint8_t unit) {
+      return unit == SS2 ? offsetX(SS1) + (W + W / 8) * RATIO_NUM / RATIO_DEN + 3
+             : (unit - FIRST) * STEP + (unit - FIRST) / 2 * GROUP;
+    }
+
+    /*!
+      @brief    Display one digit or blank a module
+      @param module   seven segment module
+      @param digit    digit 0 to 9
+      @param on       true draw the digit, false draw all the segments off
+    */
+    template <typename M>
+    static void show(M& module, int16_t digit, boolean on) {
+      if (on) {
+        module.on();
+        module.display(digit);
+      } else {
+        module.off();
+        module.display(0);
+      }
+    }
+};
+
+#endif // _TFTFixedSevenSegmentClockDisplay_H_
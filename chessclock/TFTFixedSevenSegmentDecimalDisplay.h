@@ -0,0 +1,136 @@
+/*!
+   @file TFTFixedSevenSegmentDecimalDisplay.h
+
+   This is part of the TFT Virtual Segment Display for Arduino
+   Virtual seven segments clock display for Arduino TFT LCD Displays
+   Decimal seven segment display with its geometry fixed at compile time
+
+
+   Written by Enrique Albertos, with
+   contributions from the open source community.
+
+   Public Domain
+
+*/
+
+#ifndef _TFTFixedSevenSegmentDecimalDisplay_H_
+#define _TFTFixedSevenSegmentDecimalDisplay_H_
+
+#include "arduino.h"
+#include <Adafruit_TFTLCD.h> // Hardware-specific library
+#include "TFTSevenSegmentDisplay.h"
+#include "TFTFixedSevenSegmentModule.h"
+
+/*!
+   @brief Three digit decimal display laid out by the compiler, same layout as
+          TFTSevenSegmentDecimalDisplay
+          @param W     seven segment module width
+          @param H     seven segment module height
+          @param LED   width in pixels of each segment led
+*/
+template <int16_t W, int16_t H, int16_t LED>
+class TFTFixedSevenSegmentDecimalDisplay : public TFTSevenSegmentDisplay {
+
+  public:
+    /*!
+      @brief Create a TFTFixedSevenSegmentDecimalDisplay
+         @param tft                pointer to Adafruit_TFTLCD
+         @param x                  x coordinate
+         @param y                  y coordinate
+         @param onColor            565 segment color when led segments are in on state
+         @param offColor           565 segment color when led segment are in off state
+    */
+    TFTFixedSevenSegmentDecimalDisplay(Adafruit_TFTLCD* tft, int16_t x, int16_t y, uint16_t onColor, uint16_t offColor) :
+      TFTSevenSegmentDisplay(tft, x, y, W, H, onColor, offColor, LED)
+    {
+      for (uint8_t i = 0; i < DIGITS; i++) {
+        digits[i] = Module(tft, x + (i + 1) * STEP, y, onColor, offColor);
+      }
+    }
+
+    /*!
+       @brief    Display decimal number 000 to 999
+       @param    number   number to display
+    */
+    void display(int16_t number) {
+      display((number / 100 ) % 10, (number / 10 ) % 10, number % 10);
+    }
+
+    /*!
+       @brief    Display a number from its digits, leading zeros are blanked
+        @param   hundreds number to display on the hundreds module
+        @param   tens     number to display on the tens module
+        @param   ones     number to display on the ones module
+    */
+    void display(int16_t hundreds, int16_t tens, int16_t ones) {
+      beginFrame();
+      show(digits[HUNDREDS], hundreds % 10, hundreds > 0);
+      show(digits[TENS], tens % 10, tens > 0 || hundreds > 0);
+      show(digits[ONES], ones % 10, tens > 0 || hundreds > 0 || ones > 0);
+      commitFrame();
+    }
+
+    /*!
+       @brief    Change next onColor of the led segments
+          @param color   565 segment color when led segments are in on state
+    */
+    void setOnColor(uint16_t color) override {
+      for (uint8_t i = 0; i < DIGITS; i++) {
+        digits[i].setOnColor(color);
+      }
+      m_onColor = color;
+    }
+
+    /*!
+      @brief    Change next offColor of the led segments
+      @param color   565 segment color when led segments are in off state
+    */
+    void setOffColor(uint16_t color) override {
+      for (uint8_t i = 0; i < DIGITS; i++) {
+        digits[i].setOffColor(color);
+      }
+      m_offColor = color;
+    }
+
+    /*!
+      @brief    Get the current width in pixels
+      @returns the current seven segments width in pixels
+    */
+    int16_t getWidth() override {
+      return (DIGITS - 1) * STEP + W;
+    }
+
+    /*!
+      @brief   forget what is on screen, next display call repaints every segment
+    */
+    void invalidate() override {
+      for (uint8_t i = 0; i < DIGITS; i++) {
+        digits[i].invalidate();
+      }
+    }
+
+  private:
+    typedef TFTFixedSevenSegmentModule<W, H, LED> Module;
+    static const uint8_t DIGITS = 3;
+    static const int16_t STEP = W + W / 8 + 3;  // distance between modules
+    enum Unit { HUNDREDS = 0, TENS , ONES};
+    Module digits[DIGITS];  // stored inline, no heap
+
+    /*!
+      @brief    Display one digit or blank a module
+      @param module   seven segment module
+      @param digit    digit 0 to 9
+      @param on       true draw the digit, false draw all the segments off
+    */
+    static void show(Module& module, int16_t digit, boolean on) {
+      if (on) {
+        module.on();
+        module.display(digit);
+      } else {
+        module.off();
+        module.display(0);
+      }
+    }
+};
+
+#endif // _TFTFixedSevenSegmentDecimalDisplay_H_
@@ -0,0 +1,173 @@
+/*!
+   @file TFTFixedSevenSegmentModule.h
+
+   This is part of the TFT Virtual Segment Display for Arduino
+   Virtual seven segments clock display for Arduino TFT LCD Displays
+   Seven segment module with its geometry fixed at compile time
+
+
+   Written by Enrique Albertos, with
+   contributions from the open source community.
+
+   Public Domain
+
+*/
+
+#ifndef _TFTFixedSevenSegmentModule_H_
+#define _TFTFixedSevenSegmentModule_H_
+
+#include "arduino.h"
+#include <Adafruit_TFTLCD.h> // Hardware-specific library
+#include "TFTSegmentSpan.h"
+#include "TFTSegmentBlitter.h"
+#include "TFTBusTransaction.h"
+#include "Profiler.h"
+#include "TFTSevenSegmentModule.h"
+
+/*!
+   @brief Seven segment module whose width, height and led width are template
+          parameters. The segment spans are computed by the compiler and passed
+          to the blitter as constants, only position, colors and the drawn
+          state live in RAM.
+*/
+template <int16_t W, int16_t H, int16_t LED>
+class TFTFixedSevenSegmentModule {
+  public:
+    /*!
+       @brief Create a TFTFixedSevenSegmentModule
+          @param tft       pointer to Adafruit_TFTLCD
+          @param x         x coordinate
+          @param y         y coordinate
+          @param onColor   565 segment color when led segments are in on state
+          @param offColor  565 segment color when led segment are in off state
+    */
+    TFTFixedSevenSegmentModule(Adafruit_TFTLCD* tft, int16_t x, int16_t y, uint16_t onColor, uint16_t offColor) :
+      m_tft{tft}, m_x{x}, m_y{y}, m_onColor{onColor}, m_offColor{offColor} {}
+
+    /*!
+       @brief Create an unplaced module, used for the inline storage of the displays
+    */
+    TFTFixedSevenSegmentModule() : TFTFixedSevenSegmentModule(nullptr, 0, 0, 0, 0) {}
+
+    /*!
+       @brief    Display digit 0 to 9
+        @param   digit to display
+    */
+    void display(const int16_t digit) {
+      const byte leds = m_on ? digitCodeMap[digit] : 0;
+      byte changed = leds ^ m_drawnLeds;
+      if (m_drawnLeds == NOT_DRAWN || m_drawnRotation != m_tft->getRotation()) {
+        changed = ALL_SEGMENTS;
+      }
+      if (!changed) {
+        return;
+      }
+      PROFILE_SCOPE(PROFILE_MODULE_DRAW);
+      TFTBusTransaction::begin(m_tft);
+      TFTSegmentBlitter::blitDigit<W, H, LED>(m_tft, m_x, m_y, changed, leds, m_onColor, m_offColor);
+      TFTBusTransaction::end(m_tft);
+      m_drawnLeds = leds;
+      m_drawnRotation = m_tft->getRotation();
+    }
+
+    /*!
+       @brief    Forget the last drawn digit, next display call repaints all the segments
+    */
+    void invalidate() {
+      m_drawnLeds = NOT_DRAWN;
+    }
+
+    /*!
+       @brief    Change next onColor of the led segments
+          @param color   565 segment color when led segments are in on state
+    */
+    void setOnColor(uint16_t color) {
+      if (color != m_onColor) {
+        m_onColor = color;
+        invalidate();
+      }
+    }
+
+    /*!
+      @brief    Change next offColor of the led segments
+      @param color   565 segment color when led segments are in off state
+    */
+    void setOffColor(uint16_t color) {
+      if (color != m_offColor) {
+        m_offColor = color;
+        invalidate();
+      }
+    }
+
+    /*!
+      @brief    Change state to on
+    */
+    void on() {
+      m_on = true;
+    }
+
+    /*!
+      @brief    Change state to off
+    */
+    void off() {
+      m_on = false;
+    }
+
+    /*!
+      @brief    Get the current x coordinate of the module
+      @returns the x coordinate
+    */
+    int16_t getX() const {
+      return m_x;
+    }
+
+    /*!
+      @brief    Get the current y coordinate of the module
+      @returns the y coordinate
+    */
+    int16_t getY() const {
+      return m_y;
+    }
+
+    /*!
+      @brief    Get the seven segment width in pixels
+      @returns the seven segments width in pixels
+    */
+    static constexpr int16_t getWidth() {
+      return W;
+    }
+
+    /*!
+      @brief    Get the seven segments height in pixels
+      @returns the seven segments height in pixels
+    */
+    static constexpr int16_t getHeight() {
+      return H;
+    }
+
+    /*!
+      @brief    Get the led segment width in pixels
+      @returns the led segment width in pixels
+    */
+    static constexpr int16_t getLedWidth() {
+      return LED;
+    }
+
+  private:
+    static_assert(W > 0 && W < 256 && H > 0 && H < 256, "segment spans store 8 bit coordinates");
+    static_assert(LED > 0 && LED <= TFTSegmentSpan::LINES, "led width does not fit the span line count");
+
+    static const byte ALL_SEGMENTS = B01111111;
+    static const byte NOT_DRAWN = B10000000;
+
+    Adafruit_TFTLCD * m_tft;
+    int16_t m_x;
+    int16_t m_y;
+    uint16_t m_onColor;
+    uint16_t m_offColor;
+    boolean m_on{true};
+    byte m_drawnLeds{NOT_DRAWN};  // segments lit on screen, NOT_DRAWN if unknown
+    uint8_t m_drawnRotation{};    // tft rotation used for the last drawing
+};
+
+#endif // _TFTFixedSevenSegmentModule_H_
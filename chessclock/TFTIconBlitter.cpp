@@ -0,0 +1,141 @@
+/*!
+   @file TFTIconBlitter.cpp
+
+   This is part of the TFT Virtual Segment Display for Arduino
+   Draws run length encoded 1 bit icons through the controller address window
+
+
+   Written by Enrique Albertos, with
+   contributions from the open source community.
+
+   Public Domain
+
+*/
+
+#include "TFTIconBlitter.h"
+#include "TFTSegmentBlitter.h"
+#include "TFTBusTransaction.h"
+
+#define ICON_HEADER 2 // width and height
+
+/*!
+   @brief    Draw the set pixels of an icon, the clear ones are left as they are
+   @param tft       pointer to Adafruit_TFTLCD
+   @param x         x coordinate of the icon
+   @param y         y coordinate of the icon
+   @param icon      run length encoded icon in PROGMEM
+   @param color     565 color of the set pixels
+*/
+void TFTIconBlitter::draw(Adafruit_TFTLCD* tft, int16_t x, int16_t y, const uint8_t* icon, uint16_t color) {
+  const uint8_t w = width(icon);
+  const uint8_t h = height(icon);
+  // partly off screen, let the library clip it
+  const boolean clip = !isOnScreen(tft, x, y, icon);
+  const uint8_t* runs = icon + ICON_HEADER;
+  boolean set = false;
+  uint8_t column = 0;
+  uint8_t row = 0;
+
+  TFTBusTransaction::begin(tft);
+  while (row < h) {
+    uint16_t length = pgm_read_byte(runs++);
+    while (length > 0) {
+      uint16_t pixels = w - column;
+      if (column == 0 && length >= w) {
+        // whole rows, one rectangle
+        const uint8_t rows = length / w;
+        if (set && !clip) {
+          TFTSegmentBlitter::fill(tft, x, y + row, w, rows, color);
+        } else if (set) {
+          for (uint8_t i = 0; i < rows; i++) {
+            tft->writeFastHLine(x, y + row + i, w, color);
+          }
+        }
+        row += rows;
+        length -= rows * w;
+        continue;
+      }
+      if (length < pixels) {
+        pixels = length;
+      }
+      if (set && !clip) {
+        TFTSegmentBlitter::fill(tft, x + column, y + row, pixels, 1, color);
+      } else if (set) {
+        tft->writeFastHLine(x + column, y + row, pixels, color);
+      }
+      length -= pixels;
+      column += pixels;
+      if (column == w) {
+        column = 0;
+        ++row;
+      }
+    }
+    set = !set;
+  }
+  TFTSegmentBlitter::finish(tft);
+  TFTBusTransaction::end(tft);
+}
+
+/*!
+   @brief    Draw every pixel of an icon through a single address window
+   @param tft          pointer to Adafruit_TFTLCD
+   @param x            x coordinate of the icon
+   @param y            y coordinate of the icon
+   @param icon         run length encoded icon in PROGMEM
+   @param color        565 color of the set pixels
+   @param background   565 color of the clear pixels
+*/
+void TFTIconBlitter::drawOpaque(Adafruit_TFTLCD* tft, int16_t x, int16_t y, const uint8_t* icon, uint16_t color, uint16_t background) {
+  const uint8_t w = width(icon);
+  const uint8_t h = height(icon);
+  TFTBusTransaction::begin(tft);
+  if (!isOnScreen(tft, x, y, icon)) {
+    tft->fillRect(x, y, w, h, background);
+    draw(tft, x, y, icon, color);
+    TFTBusTransaction::end(tft);
+    return;
+  }
+
+  const uint8_t* runs = icon + ICON_HEADER;
+  boolean set = false;
+  boolean first = true;
+  TFTSegmentBlitter::window(tft, x, y, w, h);
+  for (uint16_t pixels = (uint16_t)w * h; pixels > 0; set = !set) {
+    const uint8_t length = pgm_read_byte(runs++);
+    if (length > 0) {
+      TFTSegmentBlitter::stream(tft, set ? color : background, length, first);
+      first = false;
+      pixels -= length;
+    }
+  }
+  TFTSegmentBlitter::finish(tft);
+  TFTBusTransaction::end(tft);
+}
+
+/*!
+   @param icon   run length encoded icon in PROGMEM
+   @returns the icon width in pixels
+*/
+uint8_t TFTIconBlitter::width(const uint8_t* icon) {
+  return pgm_read_byte(&icon[0]);
+}
+
+/*!
+   @param icon   run length encoded icon in PROGMEM
+   @returns the icon height in pixels
+*/
+uint8_t TFTIconBlitter::height(const uint8_t* icon) {
+  return pgm_read_byte(&icon[1]);
+}
+
+/*!
+   @brief    Check if an icon is whole on screen, the address window does not clip
+   @param tft       pointer to Adafruit_TFTLCD
+   @param x         x coordinate of the icon
+   @param y         y coordinate of the icon
+   @param icon      run length encoded icon in PROGMEM
+   @returns true if no pixel is off screen
+*/
+boolean TFTIconBlitter::isOnScreen(Adafruit_TFTLCD* tft, int16_t x, int16_t y, const uint8_t* icon) {
+  return x >= 0 && y >= 0 && x + width(icon) <= tft->width() && y + height(icon) <= tft->height();
+}
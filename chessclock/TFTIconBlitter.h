@@ -0,0 +1,71 @@
+/*!
+   @file TFTIconBlitter.h
+
+   This is part of the TFT Virtual Segment Display for Arduino
+   Draws run length encoded 1 bit icons through the controller address window
+
+
+   Written by Enrique Albertos, with
+   contributions from the open source community.
+
+   Public Domain
+
+*/
+
+#ifndef _TFTIconBlitter_H_
+#define _TFTIconBlitter_H_
+
+#include "arduino.h"
+#include <Adafruit_TFTLCD.h> // Hardware-specific library
+
+/*!
+   @brief Draws icons stored in PROGMEM as runs instead of bits. An icon is its
+          width and height, one byte each, followed by the run lengths of its
+          pixels in raster order, alternating clear and set runs and starting
+          with a clear one. A run longer than 255 pixels is split by an empty
+          run of the other kind. host/icon_rle converts the 1 bit bitmaps.
+
+          drawBitmap sets the address window for every set pixel. Here a set run
+          is one window per row it covers, or one for all its whole rows, and
+          an opaque icon is one window for the whole icon.
+*/
+class TFTIconBlitter {
+  public:
+    /*!
+      @brief    Draw the set pixels of an icon, the clear ones are left as they are
+      @param tft       pointer to Adafruit_TFTLCD
+      @param x         x coordinate of the icon
+      @param y         y coordinate of the icon
+      @param icon      run length encoded icon in PROGMEM
+      @param color     565 color of the set pixels
+    */
+    static void draw(Adafruit_TFTLCD* , int16_t , int16_t , const uint8_t* , uint16_t );
+
+    /*!
+      @brief    Draw every pixel of an icon through a single address window
+      @param tft          pointer to Adafruit_TFTLCD
+      @param x            x coordinate of the icon
+      @param y            y coordinate of the icon
+      @param icon         run length encoded icon in PROGMEM
+      @param color        565 color of the set pixels
+      @param background   565 color of the clear pixels
+    */
+    static void drawOpaque(Adafruit_TFTLCD* , int16_t , int16_t , const uint8_t* , uint16_t , uint16_t );
+
+    /*!
+      @param icon   run length encoded icon in PROGMEM
+      @returns the icon width in pixels
+    */
+    static uint8_t width(const uint8_t* );
+
+    /*!
+      @param icon   run length encoded icon in PROGMEM
+      @returns the icon height in pixels
+    */
+    static uint8_t height(const uint8_t* );
+
+  private:
+    static boolean isOnScreen(Adafruit_TFTLCD* , int16_t , int16_t , const uint8_t* );
+};
+
+#endif // _TFTIconBlitter_H_
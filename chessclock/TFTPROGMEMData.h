@@ -23,11 +23,19 @@ template <typename T> void PROGMEMData (const T * sce, T& dest)
   memcpy_P (&dest, sce, sizeof (T));
   }
 
-template <typename T> T PROGMEMData (const T * sce)
+// one field of a PROGMEM struct, read in place without copying the struct
+template <typename T> T PROGMEMField (const T * sce)
   {
-  static T temp;
-  memcpy_P (&temp, sce, sizeof (T));
-  return temp;
+  switch (sizeof (T)) {
+    case 1: return (T) pgm_read_byte (sce);
+    case 2: return (T) pgm_read_word (sce);
+    case 4: return (T) pgm_read_dword (sce);
+  }
+  T value;
+  for (size_t i = 0; i < sizeof (T); i++) {
+    ((uint8_t *) &value)[i] = pgm_read_byte ((const uint8_t *) sce + i);
+  }
+  return value;
   }
 
 #endif //  _TFTPROGMEMData_H_ 
@@ -0,0 +1,212 @@
+/*!
+   @file TFTSegmentBlitter.cpp
+
+   This is part of the TFT Virtual Segment Display for Arduino
+   Fills led segment spans through the controller address window
+
+
+   Written by Enrique Albertos, with
+   contributions from the open source community.
+
+   Public Domain
+
+*/
+
+#include "TFTSegmentBlitter.h"
+
+uint16_t TFTSegmentBlitter::s_burst[TFTSegmentBlitter::BURST];
+uint16_t TFTSegmentBlitter::s_burstColor = 0;
+boolean TFTSegmentBlitter::s_windowChanged = false;
+
+/*!
+   @brief    Fill a segment span, the caller owns the bus transaction
+   @param tft       pointer to Adafruit_TFTLCD
+   @param x         x coordinate of the module
+   @param y         y coordinate of the module
+   @param span      segment span relative to the module
+   @param color     565 segment color
+*/
+void TFTSegmentBlitter::blit(Adafruit_TFTLCD* tft, int16_t x, int16_t y, const TFTSegmentSpan& span, uint16_t color) {
+  const int16_t lines = span.shape & TFTSegmentSpan::LINES;
+  const boolean vertical = span.shape & TFTSegmentSpan::VERTICAL;
+  const boolean reverse = span.shape & TFTSegmentSpan::REVERSE;
+  const boolean mirrored = span.shape & TFTSegmentSpan::MIRRORED;
+  x += span.x;
+  y += span.y;
+
+  // bounding box: along the lines and across them
+  const int16_t along0 = vertical ? y : x;
+  const int16_t along1 = along0 + span.length - 1;
+  const int16_t across = vertical ? x : y;
+  const int16_t across0 = reverse ? across - lines + 1 : across;
+  const int16_t across1 = mirrored ? across + lines : (reverse ? across : across + lines - 1);
+  if (lines == 0 || span.length <= 0
+      || along0 < 0 || across0 < 0
+      || along1 >= (vertical ? tft->height() : tft->width())
+      || across1 >= (vertical ? tft->width() : tft->height())) {
+    // partly off screen, let the library clip it
+    writeLines(tft, x, y, span, color);
+    return;
+  }
+
+  for (int16_t i = 0; i < lines; i++) {
+    const int16_t length = span.length - 2 * i;
+    if (length <= 0) {
+      break;
+    }
+    const int16_t a = reverse ? across - i : across + i;
+    if (mirrored && i == 0) {
+      // the two middle lines touch, one window covers both
+      if (vertical) {
+        fill(tft, a, along0, 2, length, color);
+      } else {
+        fill(tft, along0, a, length, 2, color);
+      }
+      continue;
+    }
+    if (vertical) {
+      fill(tft, a, along0 + i, 1, length, color);
+    } else {
+      fill(tft, along0 + i, a, length, 1, color);
+    }
+    if (mirrored) {
+      if (vertical) {
+        fill(tft, across + i + 1, along0 + i, 1, length, color);
+      } else {
+        fill(tft, along0 + i, across + i + 1, length, 1, color);
+      }
+    }
+  }
+}
+
+/*!
+   @brief    Fill the selected segments of a digit and restore the address window,
+             the caller owns the bus transaction
+   @param tft       pointer to Adafruit_TFTLCD
+   @param x         x coordinate of the module
+   @param y         y coordinate of the module
+   @param spans     the seven segment spans, A to G
+   @param progmem   true when spans are stored in PROGMEM
+   @param segments  bit mask of the segments to draw, GFEDCBA
+   @param leds      bit mask of the segments in on state, GFEDCBA
+   @param onColor   565 segment color for segments in on state
+   @param offColor  565 segment color for segments in off state
+*/
+void TFTSegmentBlitter::blitDigit(Adafruit_TFTLCD* tft, int16_t x, int16_t y, const TFTSegmentSpan* spans, boolean progmem,
+                                  byte segments, byte leds, uint16_t onColor, uint16_t offColor) {
+  for (uint8_t segment = 0; segment < 7; segment++) {
+    const byte led = 1 << segment;
+    if (segments & led) {
+      TFTSegmentSpan span;
+      if (progmem) {
+        memcpy_P(&span, &spans[segment], sizeof(TFTSegmentSpan));
+      } else {
+        span = spans[segment];
+      }
+      blit(tft, x, y, span, (leds & led) ? onColor : offColor);
+    }
+  }
+  finish(tft);
+}
+
+/*!
+   @brief    Set the address window to an on screen rectangle, its pixels are then
+             written with stream()
+   @param tft       pointer to Adafruit_TFTLCD
+   @param x         x coordinate
+   @param y         y coordinate
+   @param w         width in pixels
+   @param h         height in pixels
+*/
+void TFTSegmentBlitter::window(Adafruit_TFTLCD* tft, int16_t x, int16_t y, int16_t w, int16_t h) {
+  tft->setAddrWindow(x, y, x + w - 1, y + h - 1);
+  s_windowChanged = true;
+}
+
+/*!
+   @brief    Write pixels of one color at the address window cursor
+   @param tft       pointer to Adafruit_TFTLCD
+   @param color     565 color
+   @param pixels    number of pixels
+   @param first     true for the first pixels written after window()
+*/
+void TFTSegmentBlitter::stream(Adafruit_TFTLCD* tft, uint16_t color, uint16_t pixels, boolean first) {
+  setBurstColor(color);
+  while (pixels > 0) {
+    const uint8_t burst = pixels < BURST ? pixels : BURST;
+    tft->pushColors(s_burst, burst, first);
+    first = false;
+    pixels -= burst;
+  }
+}
+
+/*!
+   @brief    Restore the full screen address window after a run of blits
+   @param tft       pointer to Adafruit_TFTLCD
+*/
+void TFTSegmentBlitter::finish(Adafruit_TFTLCD* tft) {
+  if (s_windowChanged) {
+    tft->setAddrWindow(0, 0, tft->width() - 1, tft->height() - 1);
+    s_windowChanged = false;
+  }
+}
+
+/*!
+   @brief    Fill an on screen rectangle, the caller owns the bus transaction and
+             calls finish() after a run of fills. Runs long enough to pay for the
+             lower-right reset go through the driver flood, short ones are streamed
+             into the address window.
+   @param tft       pointer to Adafruit_TFTLCD
+   @param x         x coordinate
+   @param y         y coordinate
+   @param w         width in pixels
+   @param h         height in pixels
+   @param color     565 color
+*/
+void TFTSegmentBlitter::fill(Adafruit_TFTLCD* tft, int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
+  const uint16_t pixels = w * h;
+  if (pixels >= ((color >> 8) == (color & 0xFF) ? STROBE_FLOOD_PIXELS : FLOOD_PIXELS)) {
+    tft->fillRect(x, y, w, h, color);
+    s_windowChanged = false; // fillRect leaves the full screen window
+    return;
+  }
+  window(tft, x, y, w, h);
+  stream(tft, color, pixels, true);
+}
+
+/*!
+   @brief    Fill the burst buffer with a color, unless it already holds it
+   @param color     565 color
+*/
+void TFTSegmentBlitter::setBurstColor(uint16_t color) {
+  if (s_burstColor != color) {
+    for (uint8_t i = 0; i < BURST; i++) {
+      s_burst[i] = color;
+    }
+    s_burstColor = color;
+  }
+}
+
+/*!
+   @brief    Draw a span line by line through the clipping library calls
+   @param tft       pointer to Adafruit_TFTLCD
+   @param x         x coordinate of the span
+   @param y         y coordinate of the span
+   @param span      segment span
+   @param color     565 segment color
+*/
+void TFTSegmentBlitter::writeLines(Adafruit_TFTLCD* tft, int16_t x, int16_t y, const TFTSegmentSpan& span, uint16_t color) {
+  const uint8_t lines = span.shape & TFTSegmentSpan::LINES;
+  for (int16_t i = 0; i < lines; i++) {
+    const int16_t across = span.shape & TFTSegmentSpan::REVERSE ? -i : i;
+    const int16_t length = span.length - 2 * i;
+    if (span.shape & TFTSegmentSpan::VERTICAL) {
+      tft->writeFastVLine(x + across, y + i, length, color);
+    } else {
+      tft->writeFastHLine(x + i, y + across, length, color);
+      if (span.shape & TFTSegmentSpan::MIRRORED) {
+        tft->writeFastHLine(x + i, y + i + 1, length, color);
+      }
+    }
+  }
+}
@@ -0,0 +1,146 @@
+/*!
+   @file TFTSegmentBlitter.h
+
+   This is part of the TFT Virtual Segment Display for Arduino
+   Fills led segment spans through the controller address window
+
+
+   Written by Enrique Albertos, with
+   contributions from the open source community.
+
+   Public Domain
+
+*/
+
+#ifndef _TFTSegmentBlitter_H_
+#define _TFTSegmentBlitter_H_
+
+#include "arduino.h"
+#include <Adafruit_TFTLCD.h> // Hardware-specific library
+#include "TFTSegmentSpan.h"
+
+/*!
+   @brief Draws segment spans setting the address window once per line, or once
+          per segment when the span is a rectangle, and streaming the color in
+          bursts. drawFastHLine/drawFastVLine set the window and reset it to
+          the full screen for every single line. Runs long enough to pay for
+          that reset are still flooded by the driver, which beats the RAM burst
+          and only strobes WR when both color bytes match. The rectangle
+          primitives are shared with the icon blitter.
+*/
+class TFTSegmentBlitter {
+  public:
+    /*!
+      @brief    Fill a segment span, the caller owns the bus transaction
+      @param tft       pointer to Adafruit_TFTLCD
+      @param x         x coordinate of the module
+      @param y         y coordinate of the module
+      @param span      segment span relative to the module
+      @param color     565 segment color
+    */
+    static void blit(Adafruit_TFTLCD* , int16_t , int16_t , const TFTSegmentSpan& , uint16_t );
+
+    /*!
+      @brief    Fill the selected segments of a digit and restore the address window,
+                the caller owns the bus transaction
+      @param tft       pointer to Adafruit_TFTLCD
+      @param x         x coordinate of the module
+      @param y         y coordinate of the module
+      @param spans     the seven segment spans, A to G
+      @param progmem   true when spans are stored in PROGMEM
+      @param segments  bit mask of the segments to draw, GFEDCBA
+      @param leds      bit mask of the segments in on state, GFEDCBA
+      @param onColor   565 segment color for segments in on state
+      @param offColor  565 segment color for segments in off state
+    */
+    static void blitDigit(Adafruit_TFTLCD* , int16_t , int16_t , const TFTSegmentSpan* , boolean , byte , byte , uint16_t , uint16_t );
+
+    /*!
+      @brief    Fill the selected segments of a digit whose geometry is fixed at
+                compile time and restore the address window, the caller owns the
+                bus transaction. Each span is a constant of its blit call, no
+                table is read.
+      @param tft       pointer to Adafruit_TFTLCD
+      @param x         x coordinate of the module
+      @param y         y coordinate of the module
+      @param segments  bit mask of the segments to draw, GFEDCBA
+      @param leds      bit mask of the segments in on state, GFEDCBA
+      @param onColor   565 segment color for segments in on state
+      @param offColor  565 segment color for segments in off state
+    */
+    template <int16_t W, int16_t H, int16_t LED>
+    static void blitDigit(Adafruit_TFTLCD* tft, int16_t x, int16_t y, byte segments, byte leds, uint16_t onColor, uint16_t offColor) {
+      blitSegment<0, W, H, LED>(tft, x, y, segments, leds, onColor, offColor);
+      blitSegment<1, W, H, LED>(tft, x, y, segments, leds, onColor, offColor);
+      blitSegment<2, W, H, LED>(tft, x, y, segments, leds, onColor, offColor);
+      blitSegment<3, W, H, LED>(tft, x, y, segments, leds, onColor, offColor);
+      blitSegment<4, W, H, LED>(tft, x, y, segments, leds, onColor, offColor);
+      blitSegment<5, W, H, LED>(tft, x, y, segments, leds, onColor, offColor);
+      blitSegment<6, W, H, LED>(tft, x, y, segments, leds, onColor, offColor);
+      finish(tft);
+    }
+
+    /*!
+      @brief    Fill an on screen rectangle, the caller owns the bus transaction and
+                calls finish() after a run of fills
+      @param tft       pointer to Adafruit_TFTLCD
+      @param x         x coordinate
+      @param y         y coordinate
+      @param w         width in pixels
+      @param h         height in pixels
+      @param color     565 color
+    */
+    static void fill(Adafruit_TFTLCD* , int16_t , int16_t , int16_t , int16_t , uint16_t );
+
+    /*!
+      @brief    Set the address window to an on screen rectangle, its pixels are then
+                written with stream(); the caller owns the bus transaction and
+                calls finish() when done
+      @param tft       pointer to Adafruit_TFTLCD
+      @param x         x coordinate
+      @param y         y coordinate
+      @param w         width in pixels
+      @param h         height in pixels
+    */
+    static void window(Adafruit_TFTLCD* , int16_t , int16_t , int16_t , int16_t );
+
+    /*!
+      @brief    Write pixels of one color at the address window cursor
+      @param tft       pointer to Adafruit_TFTLCD
+      @param color     565 color
+      @param pixels    number of pixels
+      @param first     true for the first pixels written after window()
+    */
+    static void stream(Adafruit_TFTLCD* , uint16_t , uint16_t , boolean );
+
+    /*!
+      @brief    Restore the full screen address window after a run of blits
+      @param tft       pointer to Adafruit_TFTLCD
+    */
+    static void finish(Adafruit_TFTLCD* );
+
+  private:
+    static const uint8_t BURST = 16; // pixels per pushColors call
+    // runs from which fillRect pays for its lower-right reset: a flood of a color
+    // whose bytes match only strobes WR, other colors save the RAM load per pixel
+    static const uint8_t STROBE_FLOOD_PIXELS = 8;
+    static const uint8_t FLOOD_PIXELS = 20;
+    static uint16_t s_burst[BURST];
+    static uint16_t s_burstColor;
+    static boolean s_windowChanged;
+
+    static void setBurstColor(uint16_t );
+
+    // one segment of a fixed geometry digit, unrolled so that its span is folded
+    template <uint8_t SEGMENT, int16_t W, int16_t H, int16_t LED>
+    static void blitSegment(Adafruit_TFTLCD* tft, int16_t x, int16_t y, byte segments, byte leds, uint16_t onColor, uint16_t offColor) {
+      const byte led = 1 << SEGMENT;
+      if (segments & led) {
+        blit(tft, x, y, segmentSpan(SEGMENT, W, H, LED), (leds & led) ? onColor : offColor);
+      }
+    }
+
+    static void writeLines(Adafruit_TFTLCD* , int16_t , int16_t , const TFTSegmentSpan& , uint16_t );
+};
+
+#endif // _TFTSegmentBlitter_H_
@@ -0,0 +1,75 @@
+/*!
+   @file TFTSegmentSpan.h
+
+   This is part of the TFT Virtual Segment Display for Arduino
+   Geometry of the bevelled led segments of a seven segment module
+
+
+   Written by Enrique Albertos, with
+   contributions from the open source community.
+
+   Public Domain
+
+*/
+
+#ifndef _TFTSegmentSpan_H_
+#define _TFTSegmentSpan_H_
+
+#include "arduino.h"
+
+/*!
+   @brief One led segment described as a stack of lines. Line i starts one pixel
+          further along the segment, moves one pixel across it and is two pixels
+          shorter than line i - 1. Coordinates are relative to the module origin,
+          so module sizes must stay under 256 pixels.
+*/
+struct TFTSegmentSpan {
+  uint8_t x;       // x of the first line
+  uint8_t y;       // y of the first line
+  uint8_t length;  // length in pixels of the first line
+  uint8_t shape;   // number of lines and orientation flags
+
+  static const uint8_t LINES = B00011111;     // mask for the number of lines
+  static const uint8_t VERTICAL = B00100000;  // vertical lines, horizontal otherwise
+  static const uint8_t REVERSE = B01000000;   // lines move up or left across the segment
+  static const uint8_t MIRRORED = B10000000;  // each line has a twin moving the other way, one pixel apart
+};
+
+/*!
+   @brief    Build a TFTSegmentSpan
+   @param x        x of the first line
+   @param y        y of the first line
+   @param length   length of the first line
+   @param lines    number of lines
+   @param flags    orientation flags
+   @returns the span
+*/
+constexpr TFTSegmentSpan makeSegmentSpan(int16_t x, int16_t y, int16_t length, int16_t lines, uint8_t flags) {
+  return TFTSegmentSpan{ static_cast<uint8_t>(x), static_cast<uint8_t>(y), static_cast<uint8_t>(length),
+                         static_cast<uint8_t>((lines & TFTSegmentSpan::LINES) | flags) };
+}
+
+/*!
+   @brief    Compute the span of one led segment of a module
+   @param segment   segment index, 0 for A up to 6 for G
+   @param w         seven segment module width
+   @param h         seven segment module height
+   @param ledWidth  width in pixels of each segment led
+   @returns the span of the segment
+*/
+constexpr TFTSegmentSpan segmentSpan(uint8_t segment, int16_t w, int16_t h, int16_t ledWidth) {
+  return
+    segment == 0 ? (ledWidth < 2 ? makeSegmentSpan(0, 0, w, 1, 0)
+                    : makeSegmentSpan(3, 0, w - 5, ledWidth, 0)) :                                   // A
+    segment == 1 ? makeSegmentSpan(w, 0, h / 2, ledWidth, TFTSegmentSpan::VERTICAL | TFTSegmentSpan::REVERSE) : // B
+    segment == 2 ? makeSegmentSpan(w, h / 2 + 1, h / 2, ledWidth, TFTSegmentSpan::VERTICAL | TFTSegmentSpan::REVERSE) : // C
+    segment == 3 ? (ledWidth < 2 ? makeSegmentSpan(0, h, w, 1, 0)
+                    : makeSegmentSpan(3, h, w - 5, ledWidth, TFTSegmentSpan::REVERSE)) :             // D
+    segment == 4 ? makeSegmentSpan(0, h / 2 + 1, h / 2, ledWidth, TFTSegmentSpan::VERTICAL) :          // E
+    segment == 5 ? makeSegmentSpan(0, 0, h / 2, ledWidth, TFTSegmentSpan::VERTICAL) :                  // F
+    (ledWidth < 2 ? makeSegmentSpan(1, h / 2, w, 1, 0)
+     : makeSegmentSpan(2, h / 2, w - 4, ledWidth / 2 + ledWidth % 2,
+                       TFTSegmentSpan::REVERSE | TFTSegmentSpan::MIRRORED));                         // G
+}
+
+#endif // _TFTSegmentSpan_H_
@@ -0,0 +1,222 @@
+/*!
+   @file TFTSevenSegmentClock.cpp
+
+   This is part of the TFT Virtual Segment Display for Arduino
+   Virtual seven segments clock display for Arduino TFT LCD Displays
+   Abstract class for clocks with 4 or 6 seven segment modules
+
+
+   Written by Enrique Albertos, with
+   contributions from the open source community.
+
+   Public Domain
+*/
+
+#include "TFTSevenSegmentClock.h"
+
+
+#define SECONDS_IN_MINUTE 60
+#define MINUTES_IN_HOUR 60
+#define HOURS_IN_DAY 24
+#define MILLIS_IN_SECOND 1000
+#define MILLIS_IN_TENTH 100
+
+
+/*!
+   @brief    Display time from seconds
+    @param   timeSeconds   Seconds to be represented as HH:MM:SS
+    @param   units separator estate. true on, false off
+*/
+void TFTSevenSegmentClock::displaySeconds(long timeSeconds, boolean isSeparatorOn) {
+  display((timeSeconds / (SECONDS_IN_MINUTE * MINUTES_IN_HOUR)) % HOURS_IN_DAY,
+          (timeSeconds / SECONDS_IN_MINUTE) % MINUTES_IN_HOUR,
+          timeSeconds % SECONDS_IN_MINUTE, isSeparatorOn);
+}
+
+
+/*!
+   @brief    Display time from milliseconds
+    @param   timeMillis   Seconds to be represented as HH:MM:SS
+    @param   units separator estate. true on, false off
+*/
+void TFTSevenSegmentClock::displayMillis(long timeMillis, boolean isSeparatorOn) {
+  displaySeconds(timeMillis / MILLIS_IN_SECOND, isSeparatorOn);
+}
+
+/*!
+   @brief    Display seconds and tenths for the low time, S.T or SS.T
+    @param   timeMillis   time below 100 seconds, milliseconds are truncated
+*/
+void TFTSevenSegmentClock::displayTenths(long timeMillis) {
+  prepareTenths(timeMillis);
+  commitPrepared();
+}
+
+/*!
+   @brief    Display time from hour, minutes ans seconds
+    @param   hours   number to display on the hours subgroup module
+    @param   hours   number to display on the minutes subgroup module
+    @param   hours   number to display on the seconds siubgroup module
+    @param   units separator estate. true on, false off
+*/
+void TFTSevenSegmentClock::display(int16_t hours, int16_t minutes, int16_t seconds, boolean isSeparatorOn) {
+  prepare(hours, minutes, seconds, isSeparatorOn);
+  commitPrepared();
+}
+
+/*!
+   @brief    Compute the digits of a time from milliseconds, nothing is drawn
+    @param   timeMillis   time to be represented as HH:MM:SS
+    @param   isSeparatorOn separator state. true on, false off
+*/
+void TFTSevenSegmentClock::prepareMillis(long timeMillis, boolean isSeparatorOn) {
+  const long timeSeconds = timeMillis / MILLIS_IN_SECOND;
+  prepare((timeSeconds / (SECONDS_IN_MINUTE * MINUTES_IN_HOUR)) % HOURS_IN_DAY,
+          (timeSeconds / SECONDS_IN_MINUTE) % MINUTES_IN_HOUR,
+          timeSeconds % SECONDS_IN_MINUTE, isSeparatorOn);
+}
+
+/*!
+   @brief    Compute the digits of the low time layout, nothing is drawn
+    @param   timeMillis   time below 100 seconds, milliseconds are truncated
+*/
+void TFTSevenSegmentClock::prepareTenths(long timeMillis) {
+  const int16_t tenths = (timeMillis / MILLIS_IN_TENTH) % 1000;
+  const int16_t seconds = tenths / 10;
+  m_prepared.digits[HH1] = BLANK;
+  m_prepared.digits[HH2] = BLANK;
+  m_prepared.digits[MM1] = seconds > 9 ? seconds / 10 : BLANK;
+  m_prepared.digits[MM2] = seconds % 10;
+  m_prepared.digits[SS1] = tenths % 10;
+  m_prepared.digits[SS2] = BLANK;
+  m_prepared.isSeparatorOn = false;
+  m_prepared.isPointOn = true;
+  m_prepared.color = m_onColor;
+  m_prepared.isReady = true;
+}
+
+/*!
+   @brief    Compute the digits of a time from hour, minutes and seconds
+    @param   hours     number to display on the hours subgroup module
+    @param   minutes   number to display on the minutes subgroup module
+    @param   seconds   number to display on the seconds subgroup module
+    @param   isSeparatorOn separator state. true on, false off
+*/
+void TFTSevenSegmentClock::prepare(int16_t hours, int16_t minutes, int16_t seconds, boolean isSeparatorOn) {
+  m_prepared.digits[HH1] = hours > 9 ? (hours / 10) % 10 : BLANK;
+  m_prepared.digits[HH2] = hours % 10;
+  m_prepared.digits[MM1] = minutes > 9 || m_showHours ? (minutes / 10) % 10 : BLANK;
+  m_prepared.digits[MM2] = minutes % 10;
+  m_prepared.digits[SS1] = (seconds / 10) % 10;
+  m_prepared.digits[SS2] = seconds % 10;
+  m_prepared.isSeparatorOn = isSeparatorOn;
+  m_prepared.isPointOn = false;
+  m_prepared.color = m_onColor;
+  m_prepared.isReady = true;
+}
+
+/*!
+   @brief    Draw the digits computed by the last prepare call, in one frame
+    @returns false if nothing was prepared since the last commit
+*/
+boolean TFTSevenSegmentClock::commitPrepared() {
+  if (!m_prepared.isReady) {
+    return false;
+  }
+  m_prepared.isReady = false;
+  setOnColor(m_prepared.color);
+  beginFrame();
+  for (uint8_t unit = m_showHours ? HH1 : MM1; unit < DIGITS; unit++) {
+    const int8_t digit = m_prepared.digits[unit];
+    displayDigit(unit, digit == BLANK ? 0 : digit, digit != BLANK);
+  }
+  displaySeparator(m_prepared.isSeparatorOn);
+  displayDecimalPoint(m_prepared.isPointOn);
+  commitFrame();
+  return true;
+}
+
+/*!
+   @brief    Display only the HH:MM:SS separators, digits are left untouched
+    @param   isSeparatorOn separator state. true on, false off
+*/
+void TFTSevenSegmentClock::displaySeparator(boolean isSeparatorOn) {
+  if (!m_showHours) {
+    return;
+  }
+  const uint16_t color = isSeparatorOn ? m_onColor : m_offColor;
+  if (m_separatorDrawn && m_separatorColor == color && m_separatorRotation == m_tft->getRotation()) {
+    return;
+  }
+  beginFrame();
+  for (uint8_t i = 0; i < SEPARATOR_DOTS; i++) {
+    m_tft->writeFillRect(m_separators[i].x, m_separators[i].y, m_separatorSize, m_separatorSize, color);
+  }
+  commitFrame();
+  m_separatorDrawn = true;
+  m_separatorColor = color;
+  m_separatorRotation = m_tft->getRotation();
+}
+
+/*!
+   @brief   forget what is on screen, next display call repaints every segment
+*/
+void TFTSevenSegmentClock::invalidate() {
+  m_separatorDrawn = false;
+  m_pointDrawn = false;
+}
+
+/*!
+   @brief    Draw the decimal point of the low time layout, if laid out and changed
+    @param   isOn   true on, false off
+*/
+void TFTSevenSegmentClock::displayDecimalPoint(boolean isOn) {
+  if (!m_pointSize) {
+    return;
+  }
+  const uint16_t color = isOn ? m_onColor : m_offColor;
+  if (m_pointDrawn && m_pointColor == color && m_pointRotation == m_tft->getRotation()) {
+    return;
+  }
+  beginFrame();
+  m_tft->writeFillRect(m_point.x, m_point.y, m_pointSize, m_pointSize, color);
+  commitFrame();
+  m_pointDrawn = true;
+  m_pointColor = color;
+  m_pointRotation = m_tft->getRotation();
+}
+
+/*!
+   @brief    Compute the HH:MM and MM:SS colon dots from the modules geometry
+   @param hoursEnd       x coordinate right after the HH2 module
+   @param minutesX       x coordinate of the MM1 module
+   @param minutesEnd     x coordinate right after the MM2 module
+   @param secondsX       x coordinate of the SS1 module
+   @param minutesHeight  height of the hours and minutes modules
+   @param secondsHeight  height of the seconds modules
+   @param led            led width of the hours and minutes modules
+*/
+void TFTSevenSegmentClock::layoutSeparators(int16_t hoursEnd, int16_t minutesX, int16_t minutesEnd, int16_t secondsX,
+    int16_t minutesHeight, int16_t secondsHeight, int16_t led) {
+  const int16_t hoursX = hoursEnd + (minutesX - hoursEnd) / 2 - led / 4;
+  const int16_t minutesDotX = minutesEnd + (secondsX - minutesEnd) / 2 - led / 4;
+
+  m_separators[0] = { hoursX, static_cast<int16_t>(m_y + minutesHeight / 4) };
+  m_separators[1] = { hoursX, static_cast<int16_t>(m_y + 3 * minutesHeight / 4 - led / 2) };
+  m_separators[2] = { minutesDotX, static_cast<int16_t>(m_y + secondsHeight / 4) };
+  m_separators[3] = { minutesDotX, static_cast<int16_t>(m_y + 3 * secondsHeight / 4 - led / 2) };
+  m_separatorSize = m_ledWidth / 2 + 1;
+  m_separatorDrawn = false;
+}
+
+/*!
+   @brief    Place the decimal point of the low time layout
+   @param x      x coordinate
+   @param y      y coordinate
+   @param size   side of the square point
+*/
+void TFTSevenSegmentClock::layoutDecimalPoint(int16_t x, int16_t y, int16_t size) {
+  m_point = { x, y };
+  m_pointSize = size;
+  m_pointDrawn = false;
+}
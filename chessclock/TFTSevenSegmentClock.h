@@ -0,0 +1,179 @@
+/*!
+   @file TFTSevenSegmentClock.h
+
+   This is part of the TFT Virtual Segment Display for Arduino
+   Virtual seven segments clock display for Arduino TFT LCD Displays
+   Abstract class for clocks with 4 or 6 seven segment modules
+
+
+   Written by Enrique Albertos, with
+   contributions from the open source community.
+
+   Public Domain
+
+*/
+
+#ifndef _TFTSevenSegmentClock_H_
+#define _TFTSevenSegmentClock_H_
+
+#include "arduino.h"
+#include <Adafruit_TFTLCD.h> // Hardware-specific library
+#include "TFTSevenSegmentDisplay.h"
+
+/** Clock logic shared by the runtime and the compile time clock displays */
+class TFTSevenSegmentClock : public TFTSevenSegmentDisplay {
+
+  public:
+    /*!
+       @brief    Display time from hour, minutes ans seconds
+        @param   hours   number to display on the hours subgroup module
+        @param   hours   number to display on the minutes subgroup module
+        @param   hours   number to display on the seconds siubgroup module
+        @param   units separator estate. true on, false off
+    */
+    void display(int16_t ,  int16_t , int16_t, boolean );
+
+    /*!
+      @brief    Display time from seconds
+      @param   timeSeconds   Seconds to be represented as HH:MM:SS
+      @param   units separator estate. true on, false off
+    */
+    void displaySeconds(long, boolean );
+
+    /*!
+       @brief    Display time from milliseconds
+        @param   timeMillis   Seconds to be represented as HH:MM:SS
+        @param   units separator estate. true on, false off
+    */
+    void displayMillis(long, boolean );
+
+    /*!
+       @brief    Display seconds and tenths for the low time, S.T or SS.T: seconds on
+                 the minutes modules, tenths on the first seconds module, the
+                 other modules blank and a decimal point instead of the separators.
+                 Each module only repaints the segments that change, so most
+                 calls redraw part of the tenths digit alone.
+        @param   timeMillis   time below 100 seconds, milliseconds are truncated
+    */
+    void displayTenths(long );
+
+    /*!
+       @brief    Compute the digits of a time from milliseconds without drawing
+                 anything, commitPrepared() draws them. Preparing the next value
+                 ahead leaves only the pixels to push when it is due.
+        @param   timeMillis   time to be represented as HH:MM:SS
+        @param   isSeparatorOn separator state. true on, false off
+    */
+    void prepareMillis(long, boolean );
+
+    /*!
+       @brief    Compute the digits of the low time layout without drawing anything
+        @param   timeMillis   time below 100 seconds, milliseconds are truncated
+    */
+    void prepareTenths(long );
+
+    /*!
+       @brief    Draw the digits, separators and color computed by the last prepare
+                 call. The modules still compare with what is on screen, so only
+                 the segments that change are pushed.
+        @returns false if nothing was prepared since the last commit, any display
+                 call commits its own digits
+    */
+    boolean commitPrepared();
+
+    /*!
+       @brief    Display only the HH:MM:SS separators, digits are left untouched
+        @param   isSeparatorOn separator state. true on, false off
+    */
+    void displaySeparator(boolean );
+
+    /*!
+      @brief   forget what is on screen, next display call repaints every segment
+    */
+    void invalidate() override;
+
+  protected:
+    static const int16_t DIGITS = 6; // number of seven segment modules for the clock display
+    enum Unit { HH1 = 0, HH2 , MM1, MM2, SS1, SS2};
+
+    boolean m_showHours{};
+
+    TFTSevenSegmentClock() {}
+
+    /*!
+      @brief Create a clock with 4 or 6 seven segment modules
+         @param tft                pointer to Adafruit_TFTLCD
+         @param x                  x coordinate
+         @param y                  y coordinate
+         @param w                  seven segment module width
+         @param h                  seven segment module height
+         @param onColor            565 segment color when led segments are in on state
+         @param offColor           565 segment color when led segment are in off state
+         @param ledWidth           width in pixels of each segment led
+         @param showHours          true show clock with hours-minutes-seconds, false show only minutes-seconds
+    */
+    TFTSevenSegmentClock(Adafruit_TFTLCD* tft, int16_t x, int16_t y, int16_t w, int16_t h,
+                         uint16_t onColor, uint16_t offColor, int16_t ledWidth, boolean showHours) :
+      TFTSevenSegmentDisplay(tft, x, y, w, h, onColor, offColor, ledWidth),
+      m_showHours{showHours} {};
+
+    /*!
+      @brief    Display one digit on a seven segment module
+      @param unit     module, HH1 to SS2
+      @param digit    digit 0 to 9
+      @param on       true draw the digit, false draw all the segments off
+    */
+    virtual void displayDigit(uint8_t , int16_t , boolean ) = 0;
+
+    /*!
+      @brief    Compute the HH:MM and MM:SS colon dots from the modules geometry
+      @param hoursEnd       x coordinate right after the HH2 module
+      @param minutesX       x coordinate of the MM1 module
+      @param minutesEnd     x coordinate right after the MM2 module
+      @param secondsX       x coordinate of the SS1 module
+      @param minutesHeight  height of the hours and minutes modules
+      @param secondsHeight  height of the seconds modules
+      @param led            led width of the hours and minutes modules
+    */
+    void layoutSeparators(int16_t , int16_t , int16_t , int16_t , int16_t , int16_t , int16_t );
+
+    /*!
+      @brief    Place the decimal point of the low time layout
+      @param x      x coordinate
+      @param y      y coordinate
+      @param size   side of the square point
+    */
+    void layoutDecimalPoint(int16_t , int16_t , int16_t );
+
+  private:
+    static const int8_t BLANK = -1;
+    struct PreparedFrame {
+      int8_t digits[DIGITS];  // digit of each module, BLANK when off
+      boolean isSeparatorOn;
+      boolean isPointOn;
+      uint16_t color;
+      boolean isReady;
+    };
+    PreparedFrame m_prepared{};
+
+    struct SeparatorDot {
+      int16_t x;
+      int16_t y;
+    };
+    static const uint8_t SEPARATOR_DOTS = 4;
+    SeparatorDot m_separators[SEPARATOR_DOTS]{};  // HH:MM and MM:SS colon dots
+    int16_t m_separatorSize{};
+    boolean m_separatorDrawn{};                   // false when the screen content is unknown
+    uint16_t m_separatorColor{};
+    uint8_t m_separatorRotation{};
+    SeparatorDot m_point{};                       // decimal point between seconds and tenths
+    int16_t m_pointSize{};                        // 0 until laid out
+    boolean m_pointDrawn{};
+    uint16_t m_pointColor{};
+    uint8_t m_pointRotation{};
+
+    void displayDecimalPoint(boolean );
+    void prepare(int16_t , int16_t , int16_t , boolean );
+};
+
+#endif // _TFTSevenSegmentClock_H_
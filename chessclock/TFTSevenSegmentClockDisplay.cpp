@@ -14,12 +14,6 @@
 #include "TFTSevenSegmentClockDisplay.h"
 
 
-#define SECONDS_IN_MINUTE 60
-#define MINUTES_IN_HOUR 60
-#define HOURS_IN_DAY 24
-#define MILLIS_IN_SECOND 1000
-
-
 /*!
    @brief Create a TFTSevenSegmentClockDisplay represent a clock display with 4 or 6 seven segment modules
    @param tft                pointer to Adafruit_TFTLCD
@@ -40,8 +34,8 @@ TFTSevenSegmentClockDisplay::TFTSevenSegmentClockDisplay(
   int16_t h = 32,
   uint16_t onColor = 255,
   uint16_t offColor = 0,
-  int16_t ledWidth = 3) {
-  TFTSevenSegmentClockDisplay(tft, x, y, w, h, onColor, offColor, ledWidth, true, 1.0);
+  int16_t ledWidth = 3)
+  : TFTSevenSegmentClockDisplay(tft, x, y, w, h, onColor, offColor, ledWidth, true, 1.0) {
 }
 
 
@@ -71,8 +65,7 @@ TFTSevenSegmentClockDisplay::TFTSevenSegmentClockDisplay(
   boolean showHours = true,
   float secondsHeightRatio = 3 / 4)
   :
-  TFTSevenSegmentDisplay (tft, x, y, w, h, onColor, offColor, ledWidth),
-  m_showHours{showHours},
+  TFTSevenSegmentClock (tft, x, y, w, h, onColor, offColor, ledWidth, showHours),
   m_secondsHeightRatio{secondsHeightRatio}
 {
   int groupOffset = 0;
@@ -90,15 +83,15 @@ TFTSevenSegmentClockDisplay::TFTSevenSegmentClockDisplay(
       segmentWidth = m_ledWidth * m_secondsHeightRatio + 1;
     }
 
-    digits[i] = new TFTSevenSegmentModule(tft,
-                                          x + offsetx ,
-                                          y,
-                                          w,
-                                          h,
-                                          m_onColor,
-                                          m_offColor,
-                                          segmentWidth,
-                                          true);
+    digits[i] = TFTSevenSegmentModule(tft,
+                                      x + offsetx ,
+                                      y,
+                                      w,
+                                      h,
+                                      m_onColor,
+                                      m_offColor,
+                                      segmentWidth,
+                                      true);
 
     ++digit;
 
@@ -106,93 +99,47 @@ TFTSevenSegmentClockDisplay::TFTSevenSegmentClockDisplay(
       groupOffset += w / 2;
     }
   }
-  digits[SS1]->setHeight((float)h * m_secondsHeightRatio);
-  digits[SS2]->setHeight((float)h * m_secondsHeightRatio);
-  digits[SS1]->setWidth((float)w * m_secondsHeightRatio);
-  digits[SS2]->setWidth((float)w * m_secondsHeightRatio);
-}
-
-/*!
-   @brief    Display time from seconds
-    @param   timeSeconds   Seconds to be represented as HH:MM:SS
-    @param   units separator estate. true on, false off
-*/
-void TFTSevenSegmentClockDisplay::displaySeconds(long timeSeconds, boolean isSeparatorOn) {
-  display((timeSeconds / (SECONDS_IN_MINUTE * MINUTES_IN_HOUR)) % HOURS_IN_DAY,
-          (timeSeconds / SECONDS_IN_MINUTE) % MINUTES_IN_HOUR,
-          timeSeconds % SECONDS_IN_MINUTE, isSeparatorOn);
+  digits[SS1].setHeight((float)h * m_secondsHeightRatio);
+  digits[SS2].setHeight((float)h * m_secondsHeightRatio);
+  digits[SS1].setWidth((float)w * m_secondsHeightRatio);
+  digits[SS2].setWidth((float)w * m_secondsHeightRatio);
+  layoutSeparators();
 }
 
-
 /*!
-   @brief    Display time from milliseconds
-    @param   timeMillis   Seconds to be represented as HH:MM:SS
-    @param   units separator estate. true on, false off
+   @brief    Compute the HH:MM and MM:SS colon dots and the decimal point from the
+             modules geometry
 */
-void TFTSevenSegmentClockDisplay::displayMillis(long timeMillis, boolean isSeparatorOn) {
-  displaySeconds(timeMillis / MILLIS_IN_SECOND, isSeparatorOn);
+void TFTSevenSegmentClockDisplay::layoutSeparators() {
+  const int16_t minutesEnd = digits[MM2].getX() + digits[MM2].getWidth();
+  const int16_t led = digits[MM2].getLedWidth();
+  layoutDecimalPoint(minutesEnd + (digits[SS1].getX() - minutesEnd - led) / 2,
+                     m_y + digits[MM2].getHeight() - led, led);
+  if (!m_showHours) {
+    return;
+  }
+  TFTSevenSegmentClock::layoutSeparators(digits[HH2].getX() + digits[HH2].getWidth(),
+                                         digits[MM1].getX(),
+                                         digits[MM2].getX() + digits[MM2].getWidth(),
+                                         digits[SS1].getX(),
+                                         digits[MM1].getHeight(),
+                                         digits[SS1].getHeight(),
+                                         digits[MM1].getLedWidth());
 }
 
 /*!
-   @brief    Display time from hour, minutes ans seconds
-    @param   hours   number to display on the hours subgroup module
-    @param   hours   number to display on the minutes subgroup module
-    @param   hours   number to display on the seconds siubgroup module
-    @param   units separator estate. true on, false off
+   @brief    Display one digit on a seven segment module
+   @param unit     module, HH1 to SS2
+   @param digit    digit 0 to 9
+   @param on       true draw the digit, false draw all the segments off
 */
-void TFTSevenSegmentClockDisplay::display(int16_t hours, int16_t minutes, int16_t seconds, boolean isSeparatorOn) {
-
-  if (minutes > 9 || m_showHours) {
-    digits[MM1]->on();
-    digits[MM1]->display((minutes / 10) % 10);
+void TFTSevenSegmentClockDisplay::displayDigit(uint8_t unit, int16_t digit, boolean on) {
+  if (on) {
+    digits[unit].on();
+    digits[unit].display(digit);
   } else {
-    digits[MM1]->off();
-    digits[MM1]->display(0);
-  }
-
-  digits[MM2]->display(minutes % 10);
-
-  digits[SS1]->display((seconds / 10) % 10);
-
-  digits[SS2]->display(seconds % 10);
-
-  if (m_showHours) {
-    if (hours > 9) {
-      digits[HH1]->on();
-      digits[HH1]->display((hours / 10) % 10);
-    } else {
-      digits[HH1]->off();
-      digits[HH1]->display(0);
-    }
-
-
-    digits[HH2]->display(hours % 10);
-
-    m_tft->fillRect(digits[HH2]->getX() + digits[HH2]->getWidth() + (digits[MM1]->getX() - (digits[HH2]->getX() + digits[HH2]->getWidth())) / 2 -  digits[MM1]->getLedWidth() / 4,
-                    digits[HH2]->getY() + digits[MM1]->getHeight() / 4,
-                    m_ledWidth / 2 + 1 ,
-                    m_ledWidth / 2 + 1 ,
-                    isSeparatorOn == true ? m_onColor : m_offColor);
-
-    m_tft->fillRect(digits[HH2]->getX()
-                    + digits[HH2]->getWidth() + (digits[MM1]->getX() - (digits[HH2]->getX() + digits[HH2]->getWidth())) / 2 -  digits[MM1]->getLedWidth() / 4,
-                    digits[HH2]->getY() + 3 * digits[MM1]->getHeight() / 4 -  digits[MM1]->getLedWidth() / 2,
-                    m_ledWidth / 2 + 1 ,
-                    m_ledWidth / 2 + 1 ,
-                    isSeparatorOn == true ? m_onColor : m_offColor);
-
-    m_tft->fillRect(digits[MM2]->getX() + digits[MM2]->getWidth() + (digits[SS1]->getX() - (digits[MM2]->getX() + digits[MM2]->getWidth())) / 2 -  digits[MM1]->getLedWidth() / 4,
-                    digits[MM2]->getY() + digits[SS1]->getHeight() / 4,
-                    m_ledWidth / 2 + 1 ,
-                    m_ledWidth / 2 + 1 ,
-                    isSeparatorOn == true ? m_onColor : m_offColor);
-
-    m_tft->fillRect(digits[MM2]->getX()
-                    + digits[MM2]->getWidth() + (digits[SS1]->getX() - (digits[MM2]->getX() + digits[MM2]->getWidth())) / 2 -  digits[MM1]->getLedWidth() / 4,
-                    digits[MM2]->getY() + 3 * digits[SS1]->getHeight() / 4 -  digits[MM1]->getLedWidth() / 2,
-                    m_ledWidth / 2 + 1 ,
-                    m_ledWidth / 2 + 1 ,
-                    isSeparatorOn == true ? m_onColor : m_offColor);
+    digits[unit].off();
+    digits[unit].display(0);
   }
 }
 
@@ -203,7 +150,7 @@ void TFTSevenSegmentClockDisplay::display(int16_t hours, int16_t minutes, int16_
 */
 void TFTSevenSegmentClockDisplay::setOnColor(uint16_t color) {
   for (int i = m_showHours ? 0 : 2; i < DIGITS; i++) {
-    digits[i]->setOnColor(color);
+    digits[i].setOnColor(color);
   }
   m_onColor = color;
 }
@@ -215,7 +162,7 @@ void TFTSevenSegmentClockDisplay::setOnColor(uint16_t color) {
 */
 void TFTSevenSegmentClockDisplay::setOffColor(uint16_t color) {
   for (int i = m_showHours ? 0 : 2; i < DIGITS; i++) {
-    digits[i]->setOffColor(color);
+    digits[i].setOffColor(color);
   }
   m_offColor = color;
 }
@@ -226,9 +173,10 @@ void TFTSevenSegmentClockDisplay::setOffColor(uint16_t color) {
 */
 void TFTSevenSegmentClockDisplay::setLedSegmentWidth(int16_t ledWidth) {
   for (int i = m_showHours ? 0 : 2; i < DIGITS; i++) {
-    digits[i]->setLedWidth(ledWidth);
+    digits[i].setLedWidth(ledWidth);
   }
   m_ledWidth = ledWidth;
+  layoutSeparators();
 }
 
 /*!
@@ -253,7 +201,7 @@ void TFTSevenSegmentClockDisplay::setSegmentModuleHeight(int16_t h) {
       @returns the current seven segments width in pixels
 */
 int16_t TFTSevenSegmentClockDisplay::getSegmentModuleWidth() {
-  return digits[MM1]->getWidth();
+  return digits[MM1].getWidth();
 }
 
 /*!
@@ -261,7 +209,7 @@ int16_t TFTSevenSegmentClockDisplay::getSegmentModuleWidth() {
       @returns the current seven segments height in pixels
 */
 int16_t TFTSevenSegmentClockDisplay::getSegmentModuleHeight() {
-  return digits[MM1]->getHeight();
+  return digits[MM1].getHeight();
 }
 
 
@@ -271,9 +219,9 @@ int16_t TFTSevenSegmentClockDisplay::getSegmentModuleHeight() {
 */
 int16_t TFTSevenSegmentClockDisplay::getWidth() {
   if (m_showHours) {
-    return digits[SS2]->getX() + digits[SS2]->getWidth() - digits[HH1]->getX();
+    return digits[SS2].getX() + digits[SS2].getWidth() - digits[HH1].getX();
   } else {
-    return digits[SS2]->getX() + digits[SS2]->getWidth() - digits[MM1]->getX();
+    return digits[SS2].getX() + digits[SS2].getWidth() - digits[MM1].getX();
   }
 }
 
@@ -282,10 +230,10 @@ int16_t TFTSevenSegmentClockDisplay::getWidth() {
   @returns the height in pixels
 */
 int16_t TFTSevenSegmentClockDisplay::getHeight() {
-  if (digits[SS1]->getHeight() > digits[MM1]->getHeight() ) {
-    return digits[SS1]->getHeight() ;
+  if (digits[SS1].getHeight() > digits[MM1].getHeight() ) {
+    return digits[SS1].getHeight() ;
   } else {
-    return digits[MM1]->getHeight() ;
+    return digits[MM1].getHeight() ;
   }
 }
 
@@ -294,10 +242,11 @@ void TFTSevenSegmentClockDisplay::paint() {
 }
 
 /*!
-   @brief destructor deallocate memory reserved for seven segment modules
+   @brief   forget what is on screen, next display call repaints every segment
 */
-TFTSevenSegmentClockDisplay::~TFTSevenSegmentClockDisplay() {
+void TFTSevenSegmentClockDisplay::invalidate() {
   for (int i = m_showHours ? 0 : 2; i < DIGITS; i++) {
-    delete digits[i];
+    digits[i].invalidate();
   }
+  TFTSevenSegmentClock::invalidate();
 }
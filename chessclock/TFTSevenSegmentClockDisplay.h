@@ -20,12 +20,12 @@
 #include <Adafruit_GFX.h>    // Core graphics library
 #include <Adafruit_TFTLCD.h> // Hardware-specific library
 #include "TFTSevenSegmentModule.h"
-#include "TFTSevenSegmentDisplay.h"
+#include "TFTSevenSegmentClock.h"
 
 
 
 /** Virtual seven segments clock display for Arduino TFT LCD Displays */
-class TFTSevenSegmentClockDisplay : public TFTSevenSegmentDisplay {
+class TFTSevenSegmentClockDisplay : public TFTSevenSegmentClock {
 
 
   public:
@@ -46,32 +46,14 @@ class TFTSevenSegmentClockDisplay : public TFTSevenSegmentDisplay {
     TFTSevenSegmentClockDisplay(Adafruit_TFTLCD * , int16_t , int16_t , int16_t , int16_t , uint16_t , uint16_t , int16_t , boolean, float );
 
     /*!
-       @brief destructor deallocate memory reserved for seven segment modules
+       @brief copy a clock display, the copy owns its own seven segment modules
     */
-    ~TFTSevenSegmentClockDisplay();
+    TFTSevenSegmentClockDisplay(const TFTSevenSegmentClockDisplay& ) = default;
 
     /*!
-       @brief    Display time from hour, minutes ans seconds
-        @param   hours   number to display on the hours subgroup module
-        @param   hours   number to display on the minutes subgroup module
-        @param   hours   number to display on the seconds siubgroup module
-        @param   units separator estate. true on, false off
+       @brief assign a clock display, the seven segment modules are copied, not shared
     */
-    void display(int16_t ,  int16_t , int16_t, boolean );
-
-    /*!
-      @brief    Display time from seconds
-      @param   timeSeconds   Seconds to be represented as HH:MM:SS
-      @param   units separator estate. true on, false off
-    */
-    void displaySeconds(long, boolean );
-
-    /*!
-       @brief    Display time from milliseconds
-        @param   timeMillis   Seconds to be represented as HH:MM:SS
-        @param   units separator estate. true on, false off
-    */
-    void displayMillis(long, boolean );
+    TFTSevenSegmentClockDisplay& operator=(const TFTSevenSegmentClockDisplay& ) = default;
 
     /*!
       @brief    Change next drawing position of the display
@@ -138,15 +120,25 @@ class TFTSevenSegmentClockDisplay : public TFTSevenSegmentDisplay {
 
     virtual void paint();
 
+    /*!
+      @brief   forget what is on screen, next display call repaints every segment
+    */
+    void invalidate() override;
+
+  protected:
+    /*!
+      @brief    Display one digit on a seven segment module
+      @param unit     module, HH1 to SS2
+      @param digit    digit 0 to 9
+      @param on       true draw the digit, false draw all the segments off
+    */
+    void displayDigit(uint8_t , int16_t , boolean ) override;
+
   private:
-    static const int16_t DIGITS = 6; // number of seven segment modules for the clock display
-    boolean m_showHours{};
     float m_secondsHeightRatio{};
-    TFTSevenSegmentModule* digits[DIGITS];
-    enum Unit { HH1 = 0, HH2 , MM1, MM2, SS1, SS2};
-    
-
+    TFTSevenSegmentModule digits[DIGITS];  // stored inline, no heap
 
+    void layoutSeparators();
 };
 
 #endif // _TFTSevenSegmentClockDisplay_H_
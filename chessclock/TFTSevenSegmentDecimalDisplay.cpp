@@ -37,34 +37,22 @@ TFTSevenSegmentDecimalDisplay::TFTSevenSegmentDecimalDisplay(Adafruit_TFTLCD* tf
     int16_t ledWidth = 3 ) :
   TFTSevenSegmentDisplay (tft, x, y, w, h, onColor, offColor, ledWidth)
 {
-  int groupOffset = 0;
-  int digit = 0;
   int offsetx = 0;
   int segmentWidth = m_ledWidth;
   for (int i = 0 ; i < DIGITS; i++) {
     offsetx = offsetx + (w  + w / 8 ) + 3;
-    digits[i] = new TFTSevenSegmentModule(tft,
-                                          x + offsetx ,
-                                          y,
-                                          w,
-                                          h,
-                                          m_onColor,
-                                          m_offColor,
-                                          segmentWidth,
-                                          true);
-
-    ++digit;
+    digits[i] = TFTSevenSegmentModule(tft,
+                                      x + offsetx ,
+                                      y,
+                                      w,
+                                      h,
+                                      m_onColor,
+                                      m_offColor,
+                                      segmentWidth,
+                                      true);
   }
 }
 
-/*!
-   @brief destructor deallocate memory reserved for seven segment modules
-*/
-TFTSevenSegmentDecimalDisplay::~TFTSevenSegmentDecimalDisplay () {
-  for (int i = 0; i < DIGITS; i++) {
-    delete digits[i];
-  }
-}
 /*!
    @brief    Display decimal number 000 to 999
    @param    number   number to display
@@ -81,31 +69,32 @@ void TFTSevenSegmentDecimalDisplay::display(int16_t number ) {
 
 */
 void TFTSevenSegmentDecimalDisplay::display(int16_t hundreds, int16_t tens, int16_t ones) {
+  beginFrame();
 
   if (hundreds > 0) {
-    digits[HUNDREDS]->on();
-    digits[HUNDREDS]->display(hundreds % 10);
+    digits[HUNDREDS].on();
+    digits[HUNDREDS].display(hundreds % 10);
   } else {
-    digits[HUNDREDS]->off();
-    digits[HUNDREDS]->display(0);
+    digits[HUNDREDS].off();
+    digits[HUNDREDS].display(0);
   }
 
   if ( tens > 0 || hundreds > 0 ) {
-    digits[TENS]->on();
-    digits[TENS]->display(tens % 10);
+    digits[TENS].on();
+    digits[TENS].display(tens % 10);
   } else {
-    digits[TENS]->off();
-    digits[TENS]->display(0);
+    digits[TENS].off();
+    digits[TENS].display(0);
   }
 
   if ( tens > 0 || hundreds > 0 || ones > 0 ) {
-    digits[ONES]->on();
-    digits[ONES]->display(ones % 10);
+    digits[ONES].on();
+    digits[ONES].display(ones % 10);
   } else {
-    digits[ONES]->off();
-    digits[ONES]->display(0);
+    digits[ONES].off();
+    digits[ONES].display(0);
   }
-
+  commitFrame();
 }
 
 
@@ -114,7 +103,7 @@ void TFTSevenSegmentDecimalDisplay::display(int16_t hundreds, int16_t tens, int1
   @returns the current seven segments width in pixels
 */
 int16_t TFTSevenSegmentDecimalDisplay::getWidth() {
-  return digits[ONES]->getX() + digits[ONES]->getWidth() - digits[HUNDREDS]->getX();
+  return digits[ONES].getX() + digits[ONES].getWidth() - digits[HUNDREDS].getX();
 }
 
 
@@ -132,7 +121,7 @@ int16_t TFTSevenSegmentDecimalDisplay::getHeight() {
 */
 void TFTSevenSegmentDecimalDisplay::setOnColor(uint16_t color) {
   for (int i = 0; i < DIGITS; i++) {
-    digits[i]->setOnColor(color);
+    digits[i].setOnColor(color);
   }
 }
 
@@ -143,9 +132,18 @@ void TFTSevenSegmentDecimalDisplay::setOnColor(uint16_t color) {
 */
 void TFTSevenSegmentDecimalDisplay::setOffColor(uint16_t color) {
   for (int i = 0; i < DIGITS; i++) {
-    digits[i]->setOffColor(color);
+    digits[i].setOffColor(color);
   }
 }
 
 
 void TFTSevenSegmentDecimalDisplay::paint() {}
+
+/*!
+   @brief   forget what is on screen, next display call repaints every segment
+*/
+void TFTSevenSegmentDecimalDisplay::invalidate() {
+  for (int i = 0; i < DIGITS; i++) {
+    digits[i].invalidate();
+  }
+}
@@ -43,9 +43,14 @@ class TFTSevenSegmentDecimalDisplay : public TFTSevenSegmentDisplay {
     TFTSevenSegmentDecimalDisplay(Adafruit_TFTLCD * , int16_t , int16_t , int16_t , int16_t , uint16_t , uint16_t , int16_t  );
 
     /*!
-       @brief destructor deallocate memory reserved for seven segment modules
+       @brief copy a decimal display, the copy owns its own seven segment modules
     */
-    ~TFTSevenSegmentDecimalDisplay();
+    TFTSevenSegmentDecimalDisplay(const TFTSevenSegmentDecimalDisplay& ) = default;
+
+    /*!
+       @brief assign a decimal display, the seven segment modules are copied, not shared
+    */
+    TFTSevenSegmentDecimalDisplay& operator=(const TFTSevenSegmentDecimalDisplay& ) = default;
 
     /*!
        @brief    Display decimal number 000 to 999
@@ -93,9 +98,14 @@ class TFTSevenSegmentDecimalDisplay : public TFTSevenSegmentDisplay {
 
     virtual void paint();
 
+    /*!
+      @brief   forget what is on screen, next display call repaints every segment
+    */
+    void invalidate() override;
+
   private:
     static const int16_t DIGITS = 3; // number of seven segment modules for the clock display
-    TFTSevenSegmentModule* digits[DIGITS];
+    TFTSevenSegmentModule digits[DIGITS];  // stored inline, no heap
     enum Unit {HUNDREDS , TENS, ONES};
 
 
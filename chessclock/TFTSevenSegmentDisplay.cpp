@@ -15,6 +15,21 @@
 #include "TFTSevenSegmentClockDisplay.h"
 
 
+/*!
+   @brief   open a bus transaction spanning a whole frame, display calls made
+            before commitFrame() reuse it instead of opening their own
+*/
+void TFTSevenSegmentDisplay::beginFrame() {
+  TFTBusTransaction::begin(m_tft);
+}
+
+/*!
+   @brief   close the bus transaction opened by beginFrame()
+*/
+void TFTSevenSegmentDisplay::commitFrame() {
+  TFTBusTransaction::end(m_tft);
+}
+
 /*!
    @brief    Change next drawing position of the display
       @param x                  x coordinate
@@ -82,3 +97,25 @@ int16_t TFTSevenSegmentDisplay::getSegmentModuleWidth() {
 int16_t TFTSevenSegmentDisplay::getSegmentModuleHeight() {
   return m_h;
 }
+
+/*!
+  @brief    Get the current width in pixels
+  @returns the current seven segments width in pixels
+*/
+int16_t TFTSevenSegmentDisplay::getWidth() {
+  return m_w;
+}
+
+/*!
+  @brief    Get the current height in pixels
+  @returns the current seven segments height in pixels
+*/
+int16_t TFTSevenSegmentDisplay::getHeight() {
+  return m_h;
+}
+
+/*!
+  @brief   paints content to tft. Refresh data on screen
+*/
+void TFTSevenSegmentDisplay::paint() {
+}
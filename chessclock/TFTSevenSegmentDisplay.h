@@ -19,6 +19,7 @@
 #include "arduino.h"
 #include <Adafruit_TFTLCD.h> // Hardware-specific library
 #include "TFTSevenSegmentModule.h"
+#include "TFTBusTransaction.h"
 
 /** Virtual seven segments clock display for Arduino TFT LCD Displays */
 class TFTSevenSegmentDisplay {
@@ -62,7 +63,7 @@ class TFTSevenSegmentDisplay {
       m_ledWidth{ledWidth} {};;
 
     /*!
-       @brief destructor deallocate memory reserved for seven segment modules
+       @brief destructor, modules are stored inline by the displays
     */
     virtual ~TFTSevenSegmentDisplay() {};
 
@@ -74,6 +75,22 @@ class TFTSevenSegmentDisplay {
     */
     virtual void paint();
 
+    /*!
+      @brief   forget what is on screen, next display call repaints every segment
+    */
+    virtual void invalidate() = 0;
+
+    /*!
+      @brief   open a bus transaction spanning a whole frame, display calls made
+               before commitFrame() reuse it instead of opening their own
+    */
+    void beginFrame();
+
+    /*!
+      @brief   close the bus transaction opened by beginFrame()
+    */
+    void commitFrame();
+
 
     /*!
       @brief    Get the current width in pixels
@@ -18,7 +18,7 @@
 
 // The codes below indicate which segments must be illuminated to display
 // each number.
-const unsigned char digitCodeMap[] = {
+extern const unsigned char digitCodeMap[] = {
   //     GFEDCBA  Segments      7-segment map:
   B00111111,  // 0   "0"          AAA
   B00000110,  // 1   "1"         F   B
@@ -46,127 +46,54 @@ const unsigned char digitCodeMap[] = {
 
 */
 TFTSevenSegmentModule::TFTSevenSegmentModule(Adafruit_TFTLCD* tft, int16_t x = 0, int16_t y = 0, int16_t w = 16, int16_t h = 32, uint16_t onColor = 0, uint16_t offColor = 0, int16_t ledWidth = 3, boolean on = true)
-  : m_tft{ tft }, m_x{ x }, m_y{ y }, m_w{ w }, m_h{ h }, m_onColor{ onColor }, m_offColor{ offColor }, m_ledWidth{ ledWidth }, m_on{ on } {};
-
-/*!
-  @brief    Display digit 0 to 9
-  @param   digit to display
-*/
-void TFTSevenSegmentModule::display(const int16_t digit) {
-  const byte leds = digitCodeMap[digit];
-  draw_A_UpperLed((leds & 1) && m_on ? m_onColor : m_offColor);
-  draw_B_RightUpperLed((leds & 2) && m_on ? m_onColor : m_offColor);
-  draw_C_RightBottomLed((leds & 4) && m_on ? m_onColor : m_offColor);
-  draw_D_BottomLed((leds & 8) && m_on ? m_onColor : m_offColor);
-  draw_E_LeftBottomLed((leds & 16) && m_on ? m_onColor : m_offColor);
-  draw_F_LeftUpperLed((leds & 32) && m_on ? m_onColor : m_offColor);
-  draw_G_MiddleLed((leds & 64) && m_on ? m_onColor : m_offColor);
-}
-
-/*!
-  @brief    Draw F led Left Upper LED segment
-  @param   565 segement color
-*/
-void TFTSevenSegmentModule::draw_F_LeftUpperLed(uint16_t color) {
-  m_tft->startWrite();
-  for (int i = 0; i < m_ledWidth; i++) {
-    m_tft->writeFastVLine(m_x + i, m_y + i, m_h / 2 - 2 * i, color);
-  }
-  m_tft->endWrite();
-}
+  : m_tft{ tft }, m_x{ x }, m_y{ y }, m_w{ w }, m_h{ h }, m_onColor{ onColor }, m_offColor{ offColor }, m_ledWidth{ ledWidth }, m_on{ on } {
+  buildSpans();
+};
 
 /*!
-  @brief    Draw E led Left Bottom LED segment
-  @param   565 segement color
+  @brief Create an unplaced module, used for the inline storage of the displays
 */
-void TFTSevenSegmentModule::draw_E_LeftBottomLed(uint16_t color) {
-  m_tft->startWrite();
-  for (int i = 0; i < m_ledWidth; i++) {
-    m_tft->writeFastVLine(m_x + i, m_h / 2 + m_y + i + 1, m_h / 2 - 2 * i, color);
-  }
-  m_tft->endWrite();
-}
-
+TFTSevenSegmentModule::TFTSevenSegmentModule()
+  : TFTSevenSegmentModule(nullptr, 0, 0, 16, 32, 0, 0, 3, true) {};
 
 /*!
-  @brief    Draw B led Right Upper LED segment
-  @param   565 segement color
-*/
-void TFTSevenSegmentModule::draw_B_RightUpperLed(uint16_t color) {
-  m_tft->startWrite();
-  for (int i = 0; i < m_ledWidth; i++) {
-    m_tft->writeFastVLine(m_x + m_w - i, m_y + i, m_h / 2 - 2 * i, color);
-  }
-  m_tft->endWrite();
-}
-
-
-
-/*!
-  @brief    Draw C led Right Bottom LED segment
-  @param   565 segement color
+  @brief    Display digit 0 to 9
+            Only the segments whose state differs from the last drawn digit are
+            repainted. Everything is repainted after an invalidate() or after a
+            position, size, color, led width or rotation change.
+  @param   digit to display
 */
-void TFTSevenSegmentModule::draw_C_RightBottomLed(uint16_t color) {
-  m_tft->startWrite();
-  for (int i = 0; i < m_ledWidth; i++) {
-    m_tft->writeFastVLine(m_x + m_w - i, m_y + m_h / 2 + i + 1, m_h / 2 - 2 * i, color);
+void TFTSevenSegmentModule::display(const int16_t digit) {
+  const byte leds = m_on ? digitCodeMap[digit] : 0;
+  byte changed = leds ^ m_drawnLeds;
+  if (m_drawnLeds == NOT_DRAWN || m_drawnRotation != m_tft->getRotation()) {
+    changed = ALL_SEGMENTS;
   }
-  m_tft->endWrite();
-}
-
-
-/*!
-  @brief    Draw G led Middle LED segment
-  @param   565 segement color
-*/
-void TFTSevenSegmentModule::draw_G_MiddleLed(uint16_t color) {
-  m_tft->startWrite();
-  if (m_ledWidth < 2) {
-    m_tft->writeFastHLine(m_x+1, m_y + m_h / 2, m_w, color);
-  } else {
-    int ledWidth = m_ledWidth < 2 ? 1 : m_ledWidth / 2;
-    for (int i = 0; i < ledWidth + m_ledWidth % 2; i++) {
-      m_tft->writeFastHLine(m_x + i + 2, m_y + m_h / 2 - i, m_w - 2 * i - 4, color);
-      if (m_ledWidth > 1) {
-        m_tft->writeFastHLine(m_x + i + 2, m_y + m_h / 2 + i + 1, m_w - 2 * i - 4, color);
-      }
-    }
+  if (!changed) {
+    return;
   }
-  m_tft->endWrite();
+  PROFILE_SCOPE(PROFILE_MODULE_DRAW);
+  TFTBusTransaction::begin(m_tft);
+  TFTSegmentBlitter::blitDigit(m_tft, m_x, m_y, m_spans, false, changed, leds, m_onColor, m_offColor);
+  TFTBusTransaction::end(m_tft);
+  m_drawnLeds = leds;
+  m_drawnRotation = m_tft->getRotation();
 }
 
 /*!
-  @brief    Draw A led Upper LED segment
-  @param   565 segement color
+  @brief    Forget the last drawn digit, next display call repaints all the segments
 */
-void TFTSevenSegmentModule::draw_A_UpperLed(uint16_t color) {
-  m_tft->startWrite();
-  if (m_ledWidth < 2) {
-    m_tft->writeFastHLine(m_x , m_y , m_w , color);
-  } else {
-    for (int i = 0; i < m_ledWidth; i++) {
-      m_tft->writeFastHLine(m_x + i + 3, m_y + i, m_w - 2 * i - 5, color);
-    }
-  }
-  m_tft->endWrite();
-
+void TFTSevenSegmentModule::invalidate() {
+  m_drawnLeds = NOT_DRAWN;
 }
 
-
 /*!
-  @brief    Draw D led Bottom LED segment
-  @param   565 segement color
+  @brief    Rebuild the segments span table from the module geometry
 */
-void TFTSevenSegmentModule::draw_D_BottomLed(uint16_t color) {
-  m_tft->startWrite();
-  if (m_ledWidth < 2) {
-    m_tft->writeFastHLine(m_x, m_y + m_h , m_w, color);
-  } else {
-    for (int i = 0; i < m_ledWidth; i++) {
-      m_tft->writeFastHLine(m_x + i + 3, m_y + m_h - i, m_w - 2 * i - 5, color);
-    }
+void TFTSevenSegmentModule::buildSpans() {
+  for (uint8_t segment = 0; segment < SEGMENTS; segment++) {
+    m_spans[segment] = segmentSpan(segment, m_w, m_h, m_ledWidth);
   }
-  m_tft->endWrite();
 }
 
 /*!
@@ -175,6 +102,9 @@ void TFTSevenSegmentModule::draw_D_BottomLed(uint16_t color) {
   @param y                  y coordinate
 */
 void TFTSevenSegmentModule::setPosition(int16_t x, int16_t y) {
+  if (m_x != x || m_y != y) {
+    invalidate();
+  }
   m_x = x;
   m_y = y;
 }
@@ -184,6 +114,9 @@ void TFTSevenSegmentModule::setPosition(int16_t x, int16_t y) {
    @param color   565 segment color when led segments are in on state
 */
 void TFTSevenSegmentModule::setOnColor(uint16_t color) {
+  if (m_onColor != color) {
+    invalidate();
+  }
   m_onColor = color;
 }
 
@@ -192,6 +125,9 @@ void TFTSevenSegmentModule::setOnColor(uint16_t color) {
   @param color   565 segment color when led segments are in off state
 */
 void TFTSevenSegmentModule::setOffColor(uint16_t color) {
+  if (m_offColor != color) {
+    invalidate();
+  }
   m_offColor = color;
 }
 
@@ -200,7 +136,11 @@ void TFTSevenSegmentModule::setOffColor(uint16_t color) {
   @param ledWidth   led width in pixels
 */
 void TFTSevenSegmentModule::setLedWidth(int16_t ledWidth) {
+  if (m_ledWidth != ledWidth) {
+    invalidate();
+  }
   m_ledWidth = ledWidth;
+  buildSpans();
 }
 
 
@@ -209,7 +149,11 @@ void TFTSevenSegmentModule::setLedWidth(int16_t ledWidth) {
   @param h   width in pixels
 */
 void TFTSevenSegmentModule::setWidth(const int16_t w) {
+  if (m_w != w) {
+    invalidate();
+  }
   m_w = w;
+  buildSpans();
 }
 
 /*!
@@ -217,7 +161,11 @@ void TFTSevenSegmentModule::setWidth(const int16_t w) {
   @param h   heigh in pixels
 */
 void TFTSevenSegmentModule::setHeight(const int16_t h) {
+  if (m_h != h) {
+    invalidate();
+  }
   m_h = h;
+  buildSpans();
 }
 
 
@@ -226,6 +174,9 @@ void TFTSevenSegmentModule::setHeight(const int16_t h) {
   @param tft                pointer to Adafruit_TFTLCD
 */
 void TFTSevenSegmentModule::setTft(Adafruit_TFTLCD* tft) {
+  if (m_tft != tft) {
+    invalidate();
+  }
   m_tft = tft;
 }
 
@@ -18,6 +18,13 @@
 #include "arduino.h"
 #include <Adafruit_GFX.h>    // Core graphics library
 #include <Adafruit_TFTLCD.h> // Hardware-specific library
+#include "TFTSegmentSpan.h"
+#include "TFTSegmentBlitter.h"
+#include "TFTBusTransaction.h"
+#include "Profiler.h"
+
+// Segments lit for each digit 0 to 9, bit 0 is segment A up to bit 6 for segment G
+extern const unsigned char digitCodeMap[];
 
 
 
@@ -37,12 +44,22 @@ class TFTSevenSegmentModule {
     */
     TFTSevenSegmentModule(Adafruit_TFTLCD * , int16_t , int16_t , int16_t, int16_t, uint16_t , uint16_t , int16_t, boolean );
 
+    /*!
+       @brief Create an unplaced module, used for the inline storage of the displays
+    */
+    TFTSevenSegmentModule();
+
     /*!
        @brief    Display digit 0 to 9
         @param   digit to display
     */
     void display(int16_t digit);
 
+    /*!
+       @brief    Forget the last drawn digit, next display call repaints all the segments
+    */
+    void invalidate();
+
     /*!
       @brief    Change next drawing position of the module
       @param x                  x coordinate
@@ -142,16 +159,16 @@ class TFTSevenSegmentModule {
     uint16_t m_offColor;
     int16_t m_ledWidth;
     boolean m_on;
+    byte m_drawnLeds{NOT_DRAWN};  // segments lit on screen, NOT_DRAWN if unknown
+    uint8_t m_drawnRotation{};    // tft rotation used for the last drawing
 
-    void draw_F_LeftUpperLed(uint16_t ) ;
-    void draw_E_LeftBottomLed(uint16_t ) ;
-    void draw_B_RightUpperLed(uint16_t );
-    void draw_C_RightBottomLed(uint16_t ) ;
-    void draw_A_UpperLed(uint16_t );
-    void draw_G_MiddleLed(uint16_t );
-    void draw_D_BottomLed(uint16_t ) ;
+    static const uint8_t SEGMENTS = 7;
+    TFTSegmentSpan m_spans[SEGMENTS];  // segment geometry, rebuilt when size or led width change
 
+    static const byte ALL_SEGMENTS = B01111111;
+    static const byte NOT_DRAWN = B10000000;
 
+    void buildSpans();
 
 };
 
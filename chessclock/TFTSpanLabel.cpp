@@ -0,0 +1,125 @@
+/*!
+   @file TFTSpanLabel.cpp
+
+   This is part of the Arduino UNO TFT Chess Clock
+   Short text drawn from glyphs compiled into runs, instead of pixel by pixel
+
+
+   Written by Enrique Albertos, with
+   contributions from the open source community.
+
+   Public Domain
+
+*/
+
+#include "TFTSpanLabel.h"
+#include "TFTSegmentBlitter.h"
+#include "TFTBusTransaction.h"
+#include "StatusGlyphs.h"
+
+#define SPAN_LABEL_HEIGHT 8
+
+/*!
+   @brief    Forget the text
+*/
+void TFTSpanLabel::clear() {
+  m_length = 0;
+}
+
+/*!
+   @brief    Append text from PROGMEM, what does not fit is dropped
+   @param text   text to append
+*/
+void TFTSpanLabel::append(const __FlashStringHelper* text) {
+  const char* p = (const char*) text;
+  for (char c = pgm_read_byte(p); c; c = pgm_read_byte(++p)) {
+    append(c);
+  }
+}
+
+/*!
+   @brief    Append a number in decimal, what does not fit is dropped
+   @param number   number to append
+*/
+void TFTSpanLabel::append(uint16_t number) {
+  uint16_t divisor = 1;
+  while (number / divisor >= 10) {
+    divisor *= 10;
+  }
+  for (; divisor > 0; divisor /= 10) {
+    append((char)('0' + number / divisor % 10));
+  }
+}
+
+/*!
+   @brief    Append one character, dropped if the label is full
+   @param c   character to append
+*/
+void TFTSpanLabel::append(char c) {
+  if (m_length == SPAN_LABEL_CHARACTERS) {
+    return;
+  }
+  uint8_t glyph = (uint8_t) c;
+  for (uint8_t i = 0; i < STATUS_GLYPHS; i++) {
+    if ((char) pgm_read_byte(&statusGlyphChars[i]) == c) {
+      glyph = GLYPH | i;
+      break;
+    }
+  }
+  m_glyphs[m_length++] = glyph;
+}
+
+/*!
+   @returns the number of characters
+*/
+uint8_t TFTSpanLabel::length() const {
+  return m_length;
+}
+
+/*!
+   @brief    Draw the label, as tft.print would at the cursor x, y, without wrapping
+   @param tft     pointer to Adafruit_TFTLCD
+   @param x       x of the first character
+   @param y       top of the characters
+   @param color   565 text color
+   @returns the x after the last character
+*/
+int16_t TFTSpanLabel::draw(Adafruit_TFTLCD* tft, int16_t x, int16_t y, uint16_t color) const {
+  // partly off screen, let the library clip it
+  const boolean clip = x < 0 || y < 0 || x + m_length * SPAN_LABEL_ADVANCE > tft->width()
+                       || y + SPAN_LABEL_HEIGHT > tft->height();
+  TFTBusTransaction::begin(tft);
+  for (uint8_t i = 0; i < m_length; i++, x += SPAN_LABEL_ADVANCE) {
+    if (m_glyphs[i] & GLYPH) {
+      drawGlyph(tft, x, y, m_glyphs[i] & ~GLYPH, color, clip);
+    } else {
+      tft->drawChar(x, y, m_glyphs[i], color, color, 1);
+    }
+  }
+  TFTSegmentBlitter::finish(tft);
+  TFTBusTransaction::end(tft);
+  return x;
+}
+
+/*!
+   @brief    Replay the runs of a compiled glyph
+   @param tft     pointer to Adafruit_TFTLCD
+   @param x       left of the glyph
+   @param y       top of the glyph
+   @param glyph   index in StatusGlyphs.h
+   @param color   565 text color
+   @param clip    true to draw through the clipping library calls
+*/
+void TFTSpanLabel::drawGlyph(Adafruit_TFTLCD* tft, int16_t x, int16_t y, uint8_t glyph, uint16_t color, boolean clip) {
+  const uint16_t end = pgm_read_word(&statusGlyphOffsets[glyph + 1]);
+  for (uint16_t i = pgm_read_word(&statusGlyphOffsets[glyph]); i < end; i++) {
+    const uint8_t run = pgm_read_byte(&statusGlyphRuns[i]);
+    if (run == 0) {
+      ++x;
+    } else if (clip) {
+      tft->writeFastVLine(x, y + (run >> 4), run & 0x0F, color);
+    } else {
+      TFTSegmentBlitter::fill(tft, x, y + (run >> 4), 1, run & 0x0F, color);
+    }
+  }
+}
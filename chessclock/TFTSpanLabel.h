@@ -0,0 +1,80 @@
+/*!
+   @file TFTSpanLabel.h
+
+   This is part of the Arduino UNO TFT Chess Clock
+   Short text drawn from glyphs compiled into runs, instead of pixel by pixel
+
+
+   Written by Enrique Albertos, with
+   contributions from the open source community.
+
+   Public Domain
+
+*/
+
+#ifndef _TFTSpanLabel_H_
+#define _TFTSpanLabel_H_
+
+#include "arduino.h"
+#include <Adafruit_TFTLCD.h> // Hardware-specific library
+
+#define SPAN_LABEL_CHARACTERS 10  // longest label, "120m/40mv" and the like
+#define SPAN_LABEL_ADVANCE 6      // pixels from one character to the next, as the GFX font
+
+/*!
+   @brief A line of text in the classic 5x7 GFX font at size 1, transparent. The
+          text is resolved once into the glyphs of StatusGlyphs.h, whose vertical
+          runs are then replayed with one address window each; drawChar sets
+          a window for every pixel. Characters without a compiled glyph are
+          kept and drawn by drawChar.
+*/
+class TFTSpanLabel {
+  public:
+    /*!
+       @brief    Forget the text
+    */
+    void clear();
+
+    /*!
+       @brief    Append text from PROGMEM, what does not fit is dropped
+       @param text   text to append
+    */
+    void append(const __FlashStringHelper* );
+
+    /*!
+       @brief    Append a number in decimal, what does not fit is dropped
+       @param number   number to append
+    */
+    void append(uint16_t );
+
+    /*!
+       @brief    Append one character, dropped if the label is full
+       @param c   character to append
+    */
+    void append(char );
+
+    /*!
+       @returns the number of characters
+    */
+    uint8_t length() const;
+
+    /*!
+       @brief    Draw the label, as tft.print would at the cursor x, y
+       @param tft     pointer to Adafruit_TFTLCD
+       @param x       x of the first character
+       @param y       top of the characters
+       @param color   565 text color
+       @returns the x after the last character
+    */
+    int16_t draw(Adafruit_TFTLCD* , int16_t , int16_t , uint16_t ) const;
+
+  private:
+    static const uint8_t GLYPH = 0x80;  // flags a glyph index, a plain character otherwise
+
+    uint8_t m_length{};
+    uint8_t m_glyphs[SPAN_LABEL_CHARACTERS]{};
+
+    static void drawGlyph(Adafruit_TFTLCD* , int16_t , int16_t , uint8_t , uint16_t , boolean );
+};
+
+#endif // _TFTSpanLabel_H_
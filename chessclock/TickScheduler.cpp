@@ -0,0 +1,129 @@
+/*!
+   @file TickScheduler.cpp
+
+   This is part of the Arduino UNO TFT Chess Clock
+   Sleeps between deadlines instead of polling, wakes on a timer compare
+
+
+   Written by Enrique Albertos, with
+   contributions from the open source community.
+
+   Public Domain
+
+*/
+
+#include "TickScheduler.h"
+
+#if defined(__AVR__)
+#include <avr/interrupt.h>
+#include <avr/sleep.h>
+
+#define TIMER_TICK_MICROS 4     // 16 MHz / 64
+#define TIMER_MAX_TICKS 0xFFFF
+#define TIMER_MIN_TICKS 2       // a closer compare may pass before OCR1A is written
+
+static volatile boolean s_compareFired = false;
+
+ISR(TIMER1_COMPA_vect) {
+  TIMSK1 &= ~_BV(OCIE1A);
+  s_compareFired = true;
+}
+#endif
+
+/*!
+   @brief    Take over the timer, call it once from setup()
+*/
+void TickScheduler::begin() {
+#if defined(__AVR__)
+  // normal mode, prescaler 64, no PWM on pins 9 and 10
+  TCCR1A = 0;
+  TCCR1B = _BV(CS11) | _BV(CS10);
+  TIMSK1 = 0;
+  TIFR1 = _BV(OCF1A);
+#endif
+  resetStats();
+}
+
+/*!
+   @brief    Idle until micros() reaches the deadline
+   @param deadline   micros() value to wake up at, may wrap
+*/
+void TickScheduler::sleepUntil(uint32_t deadline) {
+  int32_t wait = (int32_t)(deadline - (uint32_t)micros());
+  if (wait <= 0) {
+    ++m_stats.missed;
+    account(-wait);
+    return;
+  }
+  while (wait > 0) {
+    if (!idle(wait)) {
+      return;
+    }
+    wait = (int32_t)(deadline - (uint32_t)micros());
+  }
+  account(-wait);
+}
+
+/*!
+   @returns the wake up accuracy since the last reset
+*/
+const TickStats& TickScheduler::stats() const {
+  return m_stats;
+}
+
+/*!
+   @brief    Clear the wake up accuracy counters
+*/
+void TickScheduler::resetStats() {
+  m_stats = TickStats{};
+}
+
+/*!
+   @brief    Sleep once on the timer compare, other interrupts only wake the
+             CPU to go back to sleep. A missed compare would only match after
+             a full counter wrap, 262 ms, so waits under two ticks return at
+             once and the caller polls the few micros left
+   @param micros   time to sleep, longer waits stop at the counter range
+   @returns false if the wait was cut short by the host
+*/
+boolean TickScheduler::idle(uint32_t micros) {
+#if defined(__AVR__)
+  uint32_t ticks = (micros + TIMER_TICK_MICROS - 1) / TIMER_TICK_MICROS;
+  if (ticks < TIMER_MIN_TICKS) {
+    return true;
+  }
+  if (ticks > TIMER_MAX_TICKS) {
+    ticks = TIMER_MAX_TICKS;
+  }
+  cli();
+  s_compareFired = false;
+  // clear a stale match first, one landing after the OCR1A write must stay set
+  TIFR1 = _BV(OCF1A);
+  OCR1A = TCNT1 + (uint16_t)ticks;
+  TIMSK1 |= _BV(OCIE1A);
+  set_sleep_mode(SLEEP_MODE_IDLE);
+  while (!s_compareFired) {
+    sleep_enable();
+    sei();           // the instruction after sei runs before any interrupt
+    sleep_cpu();
+    sleep_disable();
+    cli();
+  }
+  sei();
+  return true;
+#else
+  return hostTimerSleep(micros);
+#endif
+}
+
+/*!
+   @brief    Account one deadline
+   @param lateMicros   time between the deadline and the wake up
+*/
+void TickScheduler::account(uint32_t lateMicros) {
+  ++m_stats.ticks;
+  m_stats.totalLateMicros += lateMicros;
+  if (lateMicros > m_stats.maxLateMicros) {
+    m_stats.maxLateMicros = lateMicros;
+  }
+}
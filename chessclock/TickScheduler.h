@@ -0,0 +1,66 @@
+/*!
+   @file TickScheduler.h
+
+   This is part of the Arduino UNO TFT Chess Clock
+   Sleeps between deadlines instead of polling, wakes on a timer compare
+
+
+   Written by Enrique Albertos, with
+   contributions from the open source community.
+
+   Public Domain
+
+*/
+
+#ifndef _TickScheduler_H_
+#define _TickScheduler_H_
+
+#include "arduino.h"
+
+/** Wake up accuracy of the scheduler since the last reset */
+struct TickStats {
+  uint32_t ticks;            // deadlines served
+  uint32_t missed;           // deadlines already passed when the wait started
+  uint32_t maxLateMicros;    // worst wake up after a deadline
+  uint32_t totalLateMicros;  // sum of the wake up delays, for the mean
+};
+
+/*!
+   @brief Idles the CPU until a deadline. On AVR, Timer1 runs free at 4 us per
+          tick and its compare A interrupt wakes the CPU from idle sleep; waits
+          longer than the 16 bit counter are chained, waits under two ticks are
+          polled. On the host, the wait is a simulated timer that advances the
+          virtual time.
+*/
+class TickScheduler {
+  public:
+    /*!
+       @brief    Take over the timer, call it once from setup()
+    */
+    void begin();
+
+    /*!
+       @brief    Idle until micros() reaches the deadline and account how late
+                 the wake up was. Returns early if the host takes control back.
+       @param deadline   micros() value to wake up at, may wrap
+    */
+    void sleepUntil(uint32_t deadline);
+
+    /*!
+       @returns the wake up accuracy since the last reset
+    */
+    const TickStats& stats() const;
+
+    /*!
+       @brief    Clear the wake up accuracy counters
+    */
+    void resetStats();
+
+  private:
+    TickStats m_stats{};
+
+    boolean idle(uint32_t micros);
+    void account(uint32_t lateMicros);
+};
+
+#endif // _TickScheduler_H_
@@ -0,0 +1,67 @@
+/*!
+   @file TouchEventQueue.cpp
+
+   This is part of the Arduino UNO TFT Chess Clock
+   Timestamped press and release events from the touch panel
+
+
+   Written by Enrique Albertos, with
+   contributions from the open source community.
+
+   Public Domain
+
+*/
+
+#include "TouchEventQueue.h"
+
+// keep the slot access on its side of the index update
+#define COMPILER_BARRIER() __asm__ __volatile__("" ::: "memory")
+
+/*!
+   @brief    Append an event, producer side
+   @param event   event to copy
+   @returns false if the queue is full
+*/
+boolean TouchEventQueue::push(const TouchEvent& event) {
+  const uint8_t head = m_head;
+  const uint8_t next = (head + 1) & (TOUCH_EVENT_QUEUE_SIZE - 1);
+  if (next == m_tail) {
+    ++m_overflows;
+    return false;
+  }
+  m_events[head] = event;
+  COMPILER_BARRIER();
+  m_head = next;
+  return true;
+}
+
+/*!
+   @brief    Take the oldest event, consumer side
+   @param event   set to the event
+   @returns false if the queue is empty
+*/
+boolean TouchEventQueue::pop(TouchEvent& event) {
+  const uint8_t tail = m_tail;
+  if (tail == m_head) {
+    return false;
+  }
+  COMPILER_BARRIER();
+  event = m_events[tail];
+  COMPILER_BARRIER();
+  m_tail = (tail + 1) & (TOUCH_EVENT_QUEUE_SIZE - 1);
+  return true;
+}
+
+/*!
+   @returns true if there is no event to consume
+*/
+boolean TouchEventQueue::isEmpty() const {
+  return m_tail == m_head;
+}
+
+/*!
+   @returns number of events dropped because the queue was full
+*/
+uint16_t TouchEventQueue::overflows() const {
+  return m_overflows;
+}
@@ -0,0 +1,71 @@
+/*!
+   @file TouchEventQueue.h
+
+   This is part of the Arduino UNO TFT Chess Clock
+   Timestamped press and release events from the touch panel
+
+
+   Written by Enrique Albertos, with
+   contributions from the open source community.
+
+   Public Domain
+
+*/
+
+#ifndef _TouchEventQueue_H_
+#define _TouchEventQueue_H_
+
+#include "arduino.h"
+
+#define TOUCH_EVENT_QUEUE_SIZE 8  // power of two
+
+enum TouchEventType { TOUCH_PRESS = 0, TOUCH_RELEASE };
+
+/** A change of the panel state, stamped when the reading started */
+struct TouchEvent {
+  uint32_t time;    // micros() of the reading
+  uint8_t type;     // TouchEventType
+  int16_t x;        // ADC units
+  int16_t y;        // ADC units
+  int16_t z;        // pressure
+};
+
+/*!
+   @brief Single producer, single consumer ring buffer of touch events. The producer
+          only writes the head and the consumer only writes the tail, both are one
+          byte so either side may run in an interrupt without locking.
+*/
+class TouchEventQueue {
+  public:
+    /*!
+       @brief    Append an event, producer side
+       @param event   event to copy
+       @returns false if the queue is full, the event is dropped and counted
+    */
+    boolean push(const TouchEvent& );
+
+    /*!
+       @brief    Take the oldest event, consumer side
+       @param event   set to the event
+       @returns false if the queue is empty
+    */
+    boolean pop(TouchEvent& );
+
+    /*!
+       @returns true if there is no event to consume
+    */
+    boolean isEmpty() const;
+
+    /*!
+       @returns number of events dropped because the queue was full
+    */
+    uint16_t overflows() const;
+
+  private:
+    TouchEvent m_events[TOUCH_EVENT_QUEUE_SIZE];
+    volatile uint8_t m_head{};  // next slot to write
+    volatile uint8_t m_tail{};  // next slot to read
+    uint16_t m_overflows{};
+};
+
+#endif // _TouchEventQueue_H_
@@ -0,0 +1,231 @@
+/*!
+   @file TouchSampler.cpp
+
+   This is part of the Arduino UNO TFT Chess Clock
+   Reads the resistive touch panel one ADC conversion at a time
+
+
+   Written by Enrique Albertos, with
+   contributions from the open source community.
+
+   Public Domain
+
+*/
+
+#include "TouchSampler.h"
+#include "TFTBusTransaction.h"
+
+#define TOUCH_CONTACT_Z1 4  // below it the plates do not touch
+
+static volatile int16_t s_conversion = 0;
+static volatile boolean s_converted = false;
+
+#if defined(__AVR__)
+#include <avr/interrupt.h>
+
+ISR(ADC_vect) {
+  ADCSRA &= ~_BV(ADIE);
+  s_conversion = ADC;
+  s_converted = true;
+}
+#endif
+
+TouchSampler* TouchSampler::s_instance = nullptr;
+
+/*!
+   @brief Create a sampler, the pins are the ones of the TouchScreen library
+   @param xp        X+ pin, digital
+   @param yp        Y+ pin, analog
+   @param xm        X- pin, analog
+   @param ym        Y- pin, digital
+   @param rxplate   resistance across the X plate in ohms, scales the pressure
+*/
+TouchSampler::TouchSampler(uint8_t xp, uint8_t yp, uint8_t xm, uint8_t ym, uint16_t rxplate)
+  : m_xp{xp}, m_yp{yp}, m_xm{xm}, m_ym{ym}, m_rxplate{rxplate} {
+}
+
+/*!
+   @brief    Hook the sampler to the TFT bus transactions
+*/
+void TouchSampler::begin() {
+  s_instance = this;
+  TFTBusTransaction::setAcquireHook(releaseBus);
+}
+
+/*!
+   @brief    Start a new filtered reading, ignored while one is in progress
+*/
+void TouchSampler::start() {
+  if (m_step == IDLE_STEP) {
+    m_step = Z1_READING;
+  }
+}
+
+/*!
+   @brief    Start the next conversion of the reading in progress, if the bus is free
+*/
+void TouchSampler::convert() {
+  if (m_step == IDLE_STEP || m_converting || TFTBusTransaction::isOpen()) {
+    return;
+  }
+  setupPins(m_step);
+  const uint8_t pin = (m_step == Z1_READING || (m_step >= Y_READING && m_step < IDLE_STEP)) ? m_xm : m_yp;
+  m_converting = true;
+  m_started = micros();
+  if (m_step == Z1_READING) {
+    m_time = m_started;
+  }
+  s_converted = false;
+#if defined(__AVR__)
+  ADMUX = _BV(REFS0) | ((pin - A0) & 0x07);
+  ADCSRA |= _BV(ADSC) | _BV(ADIE);
+#else
+  s_conversion = analogRead(pin);
+  s_converted = true;
+#endif
+}
+
+/*!
+   @brief    Store the conversion started by convert(), waiting for it if needed
+   @returns true when it completes a reading
+*/
+boolean TouchSampler::collect() {
+  if (!m_converting) {
+    return false;
+  }
+  releaseBus();
+  m_converting = false;
+  m_readings[m_step] = m_step < X_READING ? s_conversion : 1023 - s_conversion;
+
+  if (m_step == Z1_READING && m_readings[Z1_READING] < TOUCH_CONTACT_Z1) {
+    // nothing touches the panel, the coordinates are noise
+    m_point.z = 0;
+    m_step = IDLE_STEP;
+    return true;
+  }
+  if (++m_step == IDLE_STEP) {
+    finish();
+    return true;
+  }
+  return false;
+}
+
+/*!
+   @brief    When the conversion in progress is expected to end
+   @param at   set to the micros() reading
+   @returns false if no conversion is in progress
+*/
+boolean TouchSampler::nextStepTime(uint32_t& at) const {
+  if (!m_converting) {
+    return false;
+  }
+  at = m_started + TOUCH_CONVERSION_MICROS;
+  return true;
+}
+
+/*!
+   @returns the last filtered reading
+*/
+const TSPoint& TouchSampler::point() const {
+  return m_point;
+}
+
+/*!
+   @returns micros() when the last reading started
+*/
+uint32_t TouchSampler::time() const {
+  return m_time;
+}
+
+/*!
+   @brief    Drive the plates for a reading, same pin setup as the TouchScreen library
+   @param step   reading
+*/
+void TouchSampler::setupPins(uint8_t step) {
+  if (step < X_READING) {
+    // pressure: current from Y- to X+, read both plates
+    pinMode(m_xp, OUTPUT);
+    digitalWrite(m_xp, LOW);
+    pinMode(m_ym, OUTPUT);
+    digitalWrite(m_ym, HIGH);
+    digitalWrite(m_xm, LOW);
+    pinMode(m_xm, INPUT);
+    digitalWrite(m_yp, LOW);
+    pinMode(m_yp, INPUT);
+  } else if (step < Y_READING) {
+    // x: gradient across the X plate, read it on Y+
+    pinMode(m_yp, INPUT);
+    pinMode(m_ym, INPUT);
+    digitalWrite(m_yp, LOW);
+    digitalWrite(m_ym, LOW);
+    pinMode(m_xp, OUTPUT);
+    pinMode(m_xm, OUTPUT);
+    digitalWrite(m_xp, HIGH);
+    digitalWrite(m_xm, LOW);
+  } else {
+    // y: gradient across the Y plate, read it on X-
+    pinMode(m_xp, INPUT);
+    pinMode(m_xm, INPUT);
+    digitalWrite(m_xp, LOW);
+    digitalWrite(m_xm, LOW);
+    pinMode(m_yp, OUTPUT);
+    pinMode(m_ym, OUTPUT);
+    digitalWrite(m_yp, HIGH);
+    digitalWrite(m_ym, LOW);
+  }
+}
+
+/*!
+   @brief    Filter the readings into the point, pressure in integer arithmetic
+*/
+void TouchSampler::finish() {
+  m_point.x = trimmedMean(&m_readings[X_READING]);
+  m_point.y = trimmedMean(&m_readings[Y_READING]);
+  const int32_t z1 = m_readings[Z1_READING];
+  const int32_t z2 = m_readings[Z2_READING];
+  int32_t z = (int32_t)m_point.x * m_rxplate * (z2 - z1) / z1 / 1024;
+  if (z < 0) {
+    z = 0;
+  } else if (z > 0x7FFF) {
+    z = 0x7FFF;
+  }
+  m_point.z = z;
+}
+
+/*!
+   @brief    Mean of the readings without the lowest and the highest, with three
+             readings it is the median
+   @param readings   TOUCH_OVERSAMPLING readings, sorted in place
+   @returns the filtered reading
+*/
+int16_t TouchSampler::trimmedMean(int16_t* readings) {
+  for (uint8_t i = 1; i < TOUCH_OVERSAMPLING; i++) {
+    const int16_t reading = readings[i];
+    uint8_t j = i;
+    for (; j > 0 && readings[j - 1] > reading; j--) {
+      readings[j] = readings[j - 1];
+    }
+    readings[j] = reading;
+  }
+  int16_t sum = 0;
+  for (uint8_t i = 1; i < TOUCH_OVERSAMPLING - 1; i++) {
+    sum += readings[i];
+  }
+  return sum / (TOUCH_OVERSAMPLING - 2);
+}
+
+/*!
+   @brief    Wait for the conversion in progress and give the shared pins back to the LCD,
+             XM and YP are its command/data and chip select, XP and YM its data lines D0 and D1
+*/
+void TouchSampler::releaseBus() {
+  if (!s_instance || !s_instance->m_converting) {
+    return;
+  }
+  while (!s_converted) {
+  }
+  pinMode(s_instance->m_xp, OUTPUT);
+  pinMode(s_instance->m_ym, OUTPUT);
+  pinMode(s_instance->m_xm, OUTPUT);
+  pinMode(s_instance->m_yp, OUTPUT);
+}
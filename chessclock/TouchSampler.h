@@ -0,0 +1,109 @@
+/*!
+   @file TouchSampler.h
+
+   This is part of the Arduino UNO TFT Chess Clock
+   Reads the resistive touch panel one ADC conversion at a time
+
+
+   Written by Enrique Albertos, with
+   contributions from the open source community.
+
+   Public Domain
+
+*/
+
+#ifndef _TouchSampler_H_
+#define _TouchSampler_H_
+
+#include "arduino.h"
+#include <TouchScreen.h>
+
+#define TOUCH_OVERSAMPLING 5        // readings of each axis, the lowest and highest are dropped
+#define TOUCH_CONVERSION_MICROS 120 // one conversion at the ADC clock of 125 kHz, with margin
+
+/*!
+   @brief Non blocking reader of a 4-wire resistive panel whose pins are shared with
+          the LCD. A point is the two pressure readings, TOUCH_OVERSAMPLING x readings
+          and as many y readings; each step starts one conversion, which on AVR
+          completes in the ADC interrupt. Steps only start while no bus transaction
+          is open, and a transaction that opens during a conversion waits for it, so
+          the LCD always gets its pins back between frames.
+*/
+class TouchSampler {
+  public:
+    /*!
+       @brief Create a sampler, the pins are the ones of the TouchScreen library
+       @param xp        X+ pin, digital
+       @param yp        Y+ pin, analog
+       @param xm        X- pin, analog
+       @param ym        Y- pin, digital
+       @param rxplate   resistance across the X plate in ohms, scales the pressure
+    */
+    TouchSampler(uint8_t, uint8_t, uint8_t, uint8_t, uint16_t);
+
+    /*!
+       @brief    Hook the sampler to the TFT bus transactions, call it once from setup()
+    */
+    void begin();
+
+    /*!
+       @brief    Start a new filtered reading, ignored while one is in progress
+    */
+    void start();
+
+    /*!
+       @brief    Start the next conversion of the reading in progress, if the bus is
+                 free. Call it just before idling, the conversion runs meanwhile.
+    */
+    void convert();
+
+    /*!
+       @brief    Store the conversion started by convert(), waiting for it if needed
+       @returns true when it completes a reading, point() has the result
+    */
+    boolean collect();
+
+    /*!
+       @brief    When the conversion in progress is expected to end
+       @param at   set to the micros() reading
+       @returns false if no conversion is in progress
+    */
+    boolean nextStepTime(uint32_t& at) const;
+
+    /*!
+       @returns the last filtered reading: x and y in ADC units, z the pressure, 0 if not touched
+    */
+    const TSPoint& point() const;
+
+    /*!
+       @returns micros() when the last reading started
+    */
+    uint32_t time() const;
+
+  private:
+    // pressure first, an untouched panel is known after one conversion
+    enum Step { Z1_READING = 0, Z2_READING, X_READING, Y_READING = X_READING + TOUCH_OVERSAMPLING,
+                IDLE_STEP = Y_READING + TOUCH_OVERSAMPLING
+              };
+
+    uint8_t m_xp;
+    uint8_t m_yp;
+    uint8_t m_xm;
+    uint8_t m_ym;
+    uint16_t m_rxplate;
+    uint8_t m_step{IDLE_STEP};
+    boolean m_converting{};
+    uint32_t m_started{};
+    uint32_t m_time{};
+    int16_t m_readings[2 * TOUCH_OVERSAMPLING + 2]{};
+    TSPoint m_point;
+
+    static TouchSampler* s_instance;
+
+    void setupPins(uint8_t step);
+    void finish();
+    static int16_t trimmedMean(int16_t* readings);
+    static void releaseBus();
+};
+
+#endif // _TouchSampler_H_
@@ -30,9 +30,21 @@
 #include <Adafruit_GFX.h>    // Core graphics library
 #include <Adafruit_TFTLCD.h> // Hardware-specific library
 #include <TouchScreen.h>
-#include "TFTSevenSegmentClockDisplay.h"
-#include "TFTSevenSegmentDecimalDisplay.h"
+#include "TFTFixedSevenSegmentClockDisplay.h"
+#include "TFTFixedSevenSegmentDecimalDisplay.h"
 #include "TFTPROGMEMData.h"
+#include "TFTIconBlitter.h"
+#include "TFTSpanLabel.h"
+#include "TFTBusTransaction.h"
+#include "ChessClockIcons.h"
+#include "GameTypes.h"
+#include "ClockEngine.h"
+#include "TickScheduler.h"
+#include "TouchSampler.h"
+#include "TouchEventQueue.h"
+#include "RenderQueue.h"
+#include "LatencyHistogram.h"
+#include "Profiler.h"
 
 #define PLAYER_CLOCK_HEIGHT 130
 #define MENU_COMMANDS_HEIGHT 48
@@ -41,6 +53,15 @@
 // Touch screen presure threshold
 #define MINPRESSURE 50
 #define MAXPRESSURE 1000
+#define RELEASE_PRESSURE 25 // a press lasts until the pressure drops below it
+// HH:MM:SS separator blink half period
+#define SEPARATOR_BLINK_MILLIS 500
+// Low time, seconds and tenths are shown at or below it (FIDE blitz: 10 or 20 seconds)
+#define LOW_TIME_MILLIS 10000L
+#define TENTH_MILLIS 100
+#define TOUCH_SAMPLE_MILLIS 20
+// No stage label highlighted
+#define NO_STAGE -1
 
 // The control pins for the LCD can be assigned to any digital or
 // analog pins...but we'll use the analog pins as this allows us to
@@ -62,69 +83,13 @@
 #define YELLOW  0xFFE0
 #define WHITE   0xFFFF
 
-// 'pause1', 32x32px
-const unsigned char epd_bitmap_pause [] PROGMEM = {
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x01, 0xf8, 0x3f, 0x00, 0x01, 0xfc, 0x3f, 0x80, 0x01, 0xfc, 0x3f, 0x80,
-  0x01, 0xfc, 0x3f, 0x80, 0x01, 0xfc, 0x3f, 0x80, 0x01, 0xfc, 0x3f, 0x80, 0x01, 0xfc, 0x3f, 0x80,
-  0x01, 0xfc, 0x3f, 0x80, 0x01, 0xfc, 0x3f, 0x80, 0x01, 0xfc, 0x3f, 0x80, 0x01, 0xfc, 0x3f, 0x80,
-  0x01, 0xfc, 0x3f, 0x80, 0x01, 0xfc, 0x3f, 0x80, 0x01, 0xfc, 0x3f, 0x80, 0x01, 0xfc, 0x3f, 0x80,
-  0x01, 0xfc, 0x3f, 0x80, 0x01, 0xfc, 0x3f, 0x80, 0x01, 0xfc, 0x3f, 0x80, 0x01, 0xfc, 0x3f, 0x80,
-  0x01, 0xfc, 0x3f, 0x80, 0x01, 0xfc, 0x3f, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
-};
-// 'reset', 32x32px
-const unsigned char epd_bitmap_reset [] PROGMEM = {
-  0x00, 0x00, 0x00, 0x00, 0x40, 0x1f, 0xf8, 0x00, 0x60, 0x7f, 0xfe, 0x00, 0x71, 0xff, 0xff, 0x80,
-  0x7b, 0xff, 0xff, 0xc0, 0x7f, 0xff, 0xff, 0xe0, 0x7f, 0xff, 0xff, 0xf0, 0x7f, 0xf0, 0x1f, 0xf8,
-  0x7f, 0xe0, 0x07, 0xf8, 0x7f, 0xc0, 0x03, 0xfc, 0x7f, 0xe0, 0x01, 0xfc, 0x7f, 0xf0, 0x00, 0xfe,
-  0x7f, 0xf8, 0x00, 0xfe, 0x7f, 0xfc, 0x00, 0x7e, 0x00, 0x00, 0x00, 0x7e, 0x00, 0x00, 0x00, 0x7e,
-  0x00, 0x00, 0x00, 0x7e, 0x00, 0x00, 0x00, 0x7e, 0x7e, 0x00, 0x00, 0x7e, 0x7e, 0x00, 0x00, 0xfe,
-  0x7f, 0x00, 0x00, 0xfe, 0x3f, 0x80, 0x01, 0xfc, 0x3f, 0x80, 0x03, 0xfc, 0x1f, 0xe0, 0x07, 0xf8,
-  0x1f, 0xf0, 0x1f, 0xf8, 0x0f, 0xff, 0xff, 0xf0, 0x07, 0xff, 0xff, 0xe0, 0x03, 0xff, 0xff, 0xc0,
-  0x01, 0xff, 0xff, 0x80, 0x00, 0x7f, 0xfe, 0x00, 0x00, 0x1f, 0xf8, 0x00, 0x00, 0x00, 0x00, 0x00
-};
-// 'settings', 32x32px
-const unsigned char epd_bitmap_settings [] PROGMEM = {
-  0x00, 0x07, 0xe0, 0x00, 0x00, 0x07, 0xe0, 0x00, 0x00, 0x07, 0xe0, 0x00, 0x07, 0x0f, 0xf0, 0xe0,
-  0x0f, 0xff, 0xff, 0xf0, 0x1f, 0xff, 0xff, 0xf8, 0x1f, 0xff, 0xff, 0xf8, 0x1f, 0xff, 0xff, 0xf8,
-  0x0f, 0xff, 0xff, 0xf0, 0x0f, 0xff, 0xff, 0xf0, 0x0f, 0xff, 0xff, 0xf0, 0x0f, 0xfc, 0x3f, 0xf0,
-  0x1f, 0xf0, 0x0f, 0xf8, 0xff, 0xf0, 0x0f, 0xff, 0xff, 0xe0, 0x07, 0xff, 0xff, 0xe0, 0x07, 0xff,
-  0xff, 0xe0, 0x07, 0xff, 0xff, 0xe0, 0x07, 0xff, 0xff, 0xf0, 0x0f, 0xff, 0x1f, 0xf0, 0x0f, 0xf8,
-  0x0f, 0xfc, 0x3f, 0xf0, 0x0f, 0xff, 0xff, 0xf0, 0x0f, 0xff, 0xff, 0xf0, 0x0f, 0xff, 0xff, 0xf0,
-  0x1f, 0xff, 0xff, 0xf8, 0x1f, 0xff, 0xff, 0xf8, 0x1f, 0xff, 0xff, 0xf8, 0x0f, 0xff, 0xff, 0xf0,
-  0x07, 0x0f, 0xf0, 0xe0, 0x00, 0x07, 0xe0, 0x00, 0x00, 0x07, 0xe0, 0x00, 0x00, 0x07, 0xe0, 0x00
-};
-
-// 'pawn', 16x16px
-const unsigned char epd_bitmap_pawn [] PROGMEM = { 
-0x07, 0xc0, 0x0f, 0xe0, 0x0f, 0xe0, 0x0f, 0xe0, 0x0f, 0xe0, 0x07, 0xc0, 0x03, 0x80, 0x03, 0x80, 
-0x0f, 0xe0, 0x0f, 0xe0, 0x1f, 0xf0, 0x1f, 0xf0, 0x3f, 0xf8, 0x7f, 0xfc, 0x7f, 0xfc, 0xff, 0xfe};
-
-
 enum Buttons {SETTINGS_BUTTON = 0, PAUSE_BUTTON, RESET_BUTON, BOTTOM_BUTTON, UPPER_BUTTON};
 
-enum States {IDLE = 0, SETTINGS, WHITE_PLAYING, BLACK_PLAYING, WHITE_IN_PAUSE, BLACK_IN_PAUSE, END_GAME};
+enum States {IDLE = 0, SETTINGS, WHITE_PLAYING, BLACK_PLAYING, WHITE_IN_PAUSE, BLACK_IN_PAUSE, END_GAME, STATES};
 States state = IDLE;
+States flagFellState = IDLE;  // state the game was in when a flag fell
 
-enum IncrementType { DELAY = 0, // Delay the player's clock starts after the delay period
-                     BRONSTEIN, // Players receive the used portion of the increment at the end of each turn
-                     FISCHER    // Players receive the full increment at the end of each turn, with increment 0 is BLIZT or GUILLOTINE
-                   };
-
-struct StageType {
-  long duration;
-  int moves;
-};
-
-struct GameType {
-  IncrementType incrementType;
-  uint16_t incrementSeconds;
-  uint16_t stagesNumber;
-  StageType stages[3];
-};
-
-static const GameType games[24]  PROGMEM = {
+static const GameType games[]  PROGMEM = {
   { FISCHER, 0, 1, {{ 300, 0}, {0,  0}, {0, 0}}},         // 01 Time blitz 5 min
   { FISCHER, 0, 1, {{1500, 0}, {0,  0}, {0, 0}}},         // 02 Time rapid 25 min
   { FISCHER, 0, 1, {{ 180, 0}, {0,  0}, {0, 0}}},         // 03 Time blitz 3 min
@@ -149,41 +114,150 @@ static const GameType games[24]  PROGMEM = {
   { DELAY, 10, 1, {{1500, 0}, {0, 0}, {0, 0}}},           // 22 Delay (“US DELAY”) rapid 25 min + 10 sec/move
   { DELAY, 30, 1, {{180, 0}, {0, 0}, {0, 0}}},            // 23 Delay (“US DELAY”) slow 90 min + 30 sec/move
   { DELAY, 30, 2, {{5400, 40}, {900, 0}, {0, 0}}},        // 24 Delay (“US DELAY”) tournament 90 min f.b. 15 min (all + 30sec./move)
+  { FISCHER, 0, 1, {{60, 0}, {0, 0}, {0, 0}}},            // 25 Time bullet 1 min
+  { FISCHER, 1, 1, {{60, 0}, {0, 0}, {0, 0}}},            // 26 Bonus (“Fischer”) bullet 1 min + 1 sec/move
+  { FISCHER, 1, 1, {{120, 0}, {0, 0}, {0, 0}}},           // 27 Bonus (“Fischer”) bullet 2 min + 1 sec/move
+  { FISCHER, 3, 1, {{300, 0}, {0, 0}, {0, 0}}},           // 28 Bonus (“Fischer”) blitz 5 min + 3 sec/move
+  { FISCHER, 0, 1, {{600, 0}, {0, 0}, {0, 0}}},           // 29 Time rapid 10 min
+  { FISCHER, 5, 1, {{600, 0}, {0, 0}, {0, 0}}},           // 30 Bonus (“Fischer”) rapid 10 min + 5 sec/move
+  { FISCHER, 10, 1, {{900, 0}, {0, 0}, {0, 0}}},          // 31 Bonus (“Fischer”) rapid 15 min + 10 sec/move
+  { FISCHER, 0, 1, {{1800, 0}, {0, 0}, {0, 0}}},          // 32 Time rapid 30 min
+  { FISCHER, 20, 1, {{1800, 0}, {0, 0}, {0, 0}}},         // 33 Bonus (“Fischer”) rapid 30 min + 20 sec/move
+  { FISCHER, 0, 1, {{3600, 0}, {0, 0}, {0, 0}}},          // 34 Time slow 60 min
+  { FISCHER, 30, 2, {{5400, 40}, {1800, 0}, {0, 0}}},     // 35 Bonus tournament 90 min f.b. 30 min (all + 30sec./move)
+  { BRONSTEIN, 2, 1, {{180, 0}, {0, 0}, {0, 0}}},         // 36 Delay (“Bronstein”) blitz 3 min + 2 sec./move free
 };
+const int gamesNumber = countof(games);
 int selectedGameIndex = 0 ;
-int currentStageBlacks = 0;
-int currentStageWhites = 0;
-int whitesStageMoves = 0;
-int blacksStageMoves = 0;
-GameType currentGame;
 
 const int settingsRows = 6;
 const int settingsCols = 4;
 
-StageType stages[3] = {{180, 0}, {0, 0}, {0, 0}};
+// Presets are browsed in pages of settingsRows x settingsCols cells, when they
+// do not fit in one the last cell of each page flips to the next
+const int settingsCells = settingsRows * settingsCols;
+const int settingsPages = gamesNumber <= settingsCells ? 1 : (gamesNumber + settingsCells - 2) / (settingsCells - 1);
+const int gamesPerPage = settingsPages == 1 ? settingsCells : settingsCells - 1;
+int settingsPage = 0;
+#define SETTINGS_ROW_CLEAR 0x100  // paintSettingsRow argument flag, clear the row first
 
 Adafruit_TFTLCD tft(LCD_CS, LCD_CD, LCD_WR, LCD_RD, LCD_RESET);
 // If using the shield, all control and data lines are fixed, and
 // a simpler declaration can optionally be used:
 // Adafruit_TFTLCD tft;
 
-uint16_t blacksmoves = 0; // movement counter for blacks
-uint16_t whitesmoves = 0; // movement counter for whitess
-
-unsigned long blacksTimeMillis = 0; // Whites time left
-unsigned long whitesTimeMillis = 0; // Blacks time left
-unsigned long blacksOldTimeMillis = 0; // used to decide if clock needs refresh
-unsigned long whitesOldTimeMillis = 0; // used to decide if clock needs refresh
-
-unsigned long whitesTurnInitMillis = millis();
-unsigned long blacksTurnInitMillis = millis();
-unsigned long whitesEllapsedTimeMillis = millis();
-unsigned long blacksEllapsedTimeMillis = millis();
-
-bool isNewTurn; // new player turn change
-
 bool isWhiteDown = false; // White's clock is the one at the bottom of the screen
-unsigned long lastTimeTouch = 0; // time since last touch of the screen for de-bouncing
+// Touch zones, each one de-bounced on its own: a press on the other player's half
+// registers at once while a bounce on the same zone is ignored
+enum TouchZone {TOP_ZONE = 0, BOTTOM_ZONE, BUTTONS_ZONE, SETTINGS_ZONE, TOUCH_ZONES};
+const uint32_t zoneDebounceMicros[TOUCH_ZONES] = {60000L, 60000L, 300000L, 300000L};
+uint32_t zoneLastPress[TOUCH_ZONES] = {}; // time of the last accepted press of each zone
+
+bool isPanelPressed = false;  // panel state after the last reading
+TouchZone pressedZone = TOP_ZONE; // zone under the finger while pressed
+
+// Hit test of a press in touch coordinates of the initial rotation: the clocks,
+// and the strip between them split in thirds, with the button row in its middle
+enum HitZone {HIT_TOP = 0, HIT_BOTTOM, HIT_STRIP_LEFT, HIT_STRIP_CENTER, HIT_STRIP_RIGHT,
+              HIT_BUTTON_LEFT, HIT_BUTTON_CENTER, HIT_BUTTON_RIGHT, HIT_ZONES
+             };
+
+// Zone limits as raw touch readings, computed once by layoutTouchZones so the hit
+// test only compares. Keys grow with the screen coordinate: the raw x, minus the raw y.
+struct TouchLayout {
+  int16_t stripTop;       // first y key of the strip
+  int16_t stripBottom;    // first y key of the bottom clock
+  int16_t buttonsTop;     // first y key of the button row
+  int16_t buttonsBottom;  // first y key below the button row
+  int16_t centerLeft;     // first x key of the centre third
+  int16_t rightLeft;      // first x key of the right third
+  int16_t columns[settingsCols - 1]; // first x key of each settings column but the first
+  int16_t rows[settingsRows - 1];    // first y key of each settings row but the first
+};
+TouchLayout touchLayout;
+
+enum UiAction {NO_ACTION = 0, RESET_ACTION, SETTINGS_ACTION, SELECT_GAME_ACTION, START_WHITE_UP_ACTION,
+               START_WHITE_DOWN_ACTION, PAUSE_ACTION, RESUME_ACTION, FLIP_ACTION, UI_ACTIONS
+              };
+
+// UI transitions by white's side, state and hit zone: the clocks, then the strip
+// thirds, then the button row thirds
+static const uint8_t uiTransitions[2][STATES][HIT_ZONES] PROGMEM = {
+  { // white up, white moves on the bottom half
+    { // IDLE
+      START_WHITE_UP_ACTION, START_WHITE_DOWN_ACTION,
+      SETTINGS_ACTION, START_WHITE_DOWN_ACTION, RESET_ACTION,
+      SETTINGS_ACTION, START_WHITE_DOWN_ACTION, RESET_ACTION
+    },
+    { // SETTINGS
+      SELECT_GAME_ACTION, SELECT_GAME_ACTION,
+      SELECT_GAME_ACTION, SELECT_GAME_ACTION, SELECT_GAME_ACTION,
+      SELECT_GAME_ACTION, SELECT_GAME_ACTION, SELECT_GAME_ACTION
+    },
+    { // WHITE_PLAYING
+      NO_ACTION, FLIP_ACTION,
+      PAUSE_ACTION, PAUSE_ACTION, PAUSE_ACTION,
+      PAUSE_ACTION, PAUSE_ACTION, PAUSE_ACTION
+    },
+    { // BLACK_PLAYING
+      FLIP_ACTION, NO_ACTION,
+      PAUSE_ACTION, PAUSE_ACTION, PAUSE_ACTION,
+      PAUSE_ACTION, PAUSE_ACTION, PAUSE_ACTION
+    },
+    { // WHITE_IN_PAUSE
+      NO_ACTION, NO_ACTION,
+      NO_ACTION, NO_ACTION, NO_ACTION,
+      SETTINGS_ACTION, RESUME_ACTION, RESET_ACTION
+    },
+    { // BLACK_IN_PAUSE
+      NO_ACTION, NO_ACTION,
+      NO_ACTION, NO_ACTION, NO_ACTION,
+      SETTINGS_ACTION, RESUME_ACTION, RESET_ACTION
+    },
+    { // END_GAME
+      RESET_ACTION, RESET_ACTION,
+      RESET_ACTION, RESET_ACTION, RESET_ACTION,
+      RESET_ACTION, RESET_ACTION, RESET_ACTION
+    },
+  },
+  { // white down, white moves on the top half
+    { // IDLE
+      START_WHITE_UP_ACTION, START_WHITE_DOWN_ACTION,
+      SETTINGS_ACTION, START_WHITE_DOWN_ACTION, RESET_ACTION,
+      SETTINGS_ACTION, START_WHITE_DOWN_ACTION, RESET_ACTION
+    },
+    { // SETTINGS
+      SELECT_GAME_ACTION, SELECT_GAME_ACTION,
+      SELECT_GAME_ACTION, SELECT_GAME_ACTION, SELECT_GAME_ACTION,
+      SELECT_GAME_ACTION, SELECT_GAME_ACTION, SELECT_GAME_ACTION
+    },
+    { // WHITE_PLAYING
+      FLIP_ACTION, NO_ACTION,
+      PAUSE_ACTION, PAUSE_ACTION, PAUSE_ACTION,
+      PAUSE_ACTION, PAUSE_ACTION, PAUSE_ACTION
+    },
+    { // BLACK_PLAYING
+      NO_ACTION, FLIP_ACTION,
+      PAUSE_ACTION, PAUSE_ACTION, PAUSE_ACTION,
+      PAUSE_ACTION, PAUSE_ACTION, PAUSE_ACTION
+    },
+    { // WHITE_IN_PAUSE
+      NO_ACTION, NO_ACTION,
+      NO_ACTION, NO_ACTION, NO_ACTION,
+      SETTINGS_ACTION, RESUME_ACTION, RESET_ACTION
+    },
+    { // BLACK_IN_PAUSE
+      NO_ACTION, NO_ACTION,
+      NO_ACTION, NO_ACTION, NO_ACTION,
+      SETTINGS_ACTION, RESUME_ACTION, RESET_ACTION
+    },
+    { // END_GAME
+      RESET_ACTION, RESET_ACTION,
+      RESET_ACTION, RESET_ACTION, RESET_ACTION,
+      RESET_ACTION, RESET_ACTION, RESET_ACTION
+    },
+  }
+};
 
 uint16_t blacksRotation =  2; // initial orientation of the black pieces until field is chosen
 uint16_t whitesRotation =  0; // initial orientation of the black pieces until field is chosen
@@ -191,7 +265,8 @@ uint16_t whitesRotation =  0; // initial orientation of the black pieces until f
 // Touch screen callibration
 const int XP = 8, XM = A2, YP = A3, YM = 9; //240x320 ID=0x9341
 const int TS_LEFT = 918, TS_RT = 106, TS_TOP = 76, TS_BOT = 898;
-const TouchScreen ts = TouchScreen(XP, YP, XM, YM, 300);
+TouchSampler touchSampler(XP, YP, XM, YM, 300);
+TouchEventQueue touchEvents;  // filled by queueTouchEvents, drained by readUiSelection
 
 
 uint16_t backgroundColor = BLUE;
@@ -200,14 +275,160 @@ uint16_t pauseColor = tft.color565(30, 30, 30);
 uint16_t alertColor = RED;
 
 // Clock displays
-TFTSevenSegmentClockDisplay clockDisplayMinutes(&tft, 30, 215, 35, 70, WHITE, backgroundColor, 8, false, .75); // Short games
-TFTSevenSegmentClockDisplay clockDisplayHours(&tft, 10, 215, 26, 60, WHITE, backgroundColor, 6, true, .75); // Long games
+// geometry is fixed at compile time: module width, height, led width, hours, seconds ratio 3/4
+TFTFixedSevenSegmentClockDisplay<35, 70, 8, false, 3, 4> clockDisplayMinutes(&tft, 30, 215, WHITE, backgroundColor); // Short games
+TFTFixedSevenSegmentClockDisplay<26, 60, 6, true, 3, 4> clockDisplayHours(&tft, 10, 215, WHITE, backgroundColor); // Long games
 
 // Moves counter display
-TFTSevenSegmentDecimalDisplay movesDisplay(&tft, 180, 290, 5, 8, foregroundColor, backgroundColor, 1);
+TFTFixedSevenSegmentDecimalDisplay<5, 8, 1> movesDisplay(&tft, 180, 290, foregroundColor, backgroundColor);
+
+// US delay countdown, blank outside the delay period
+TFTFixedSevenSegmentDecimalDisplay<8, 14, 2> delayDisplay(&tft, 176, 197, foregroundColor, backgroundColor);
+
+// Status labels of a game, composed once and replayed on every repaint
+struct GameLabels {
+  TFTSpanLabel modeName;
+  TFTSpanLabel delay;
+  TFTSpanLabel stages[3];
+};
+
+// Labels of the game being played. The settings page is only left by loading the
+// selected game, so while it is shown they cache the highlighted cell instead
+GameLabels gameLabels;
+TFTSpanLabel stagesTitle;  // same for every game
+
+// Current display, switched between the layouts without copying them
+TFTSevenSegmentClock* clockDisplay = &clockDisplayMinutes;
+
+// Retained screen model, what each player panel shows right now. Widgets are
+// repainted only when their state differs from the cached one or when the
+// panel has been invalidated by a full screen repaint.
+enum PanelWidgets {BORDER_WIDGET = 1, LABELS_WIDGET = 2, CLOCK_WIDGET = 4, MOVES_WIDGET = 8, DELAY_WIDGET = 16, ALL_WIDGETS = 31};
+
+struct PanelView {
+  byte dirty;             // widgets whose content on screen is unknown
+  uint16_t borderColor;
+  uint16_t labelColor;
+  int highlightedStage;   // stage label drawn in foregroundColor, NO_STAGE if none
+  long clockUnits;        // seconds shown, tenths in low time
+  bool clockTenths;
+  uint16_t clockColor;
+  uint16_t moves;
+  uint16_t movesColor;
+  uint8_t delaySeconds;   // 0 when blank
+  uint16_t delayColor;
+};
+
+// panels by screen position, INITIAL_ROTATION first
+PanelView panels[2] = {{ALL_WIDGETS}, {ALL_WIDGETS}};
+
+// Next clock of the player on move, its digits computed by the display right after
+// the previous change so that the boundary only pushes pixels
+struct PreparedClock {
+  bool isReady;
+  uint8_t player;
+  ClockMicros boundary;   // remaining time the prepared clock is shown from
+  PanelView* panel;
+  long time;              // shown time
+  uint16_t color;
+  bool isSeparatorOn;
+  long units;             // as cached in the panel view
+  bool isLowTime;
+};
+PreparedClock preparedClock;
+
+// Time from a clock boundary to the first pixel of the clock change
+LatencyHistogram boundaryLatency;
+bool isBoundaryPending = false;
+
+// Prototypes, the Arduino IDE generates them but other toolchains (the host build) need them
+uint32_t clockMicros();
+long displayMillis(const ClockMicros remaining);
+uint16_t playerRotation(uint8_t player);
+void onDisplayedTimeChanged(uint8_t player, ClockMicros remaining);
+void prepareNextClock(uint8_t player);
+void markFirstPixel();
+void onFlagFell(uint8_t player, ClockMicros remaining);
+void onDelayChanged(uint8_t player, ClockMicros delayLeft);
+uint8_t panelDelaySeconds(const int rotation);
+void printClocks();
+uint32_t nextDeadline();
+void resetGame(void);
+void printClockMode(uint16_t color);
+void printStages(int16_t x, int16_t y, uint16_t color, bool showSelected, int stageSelected);
+void printClockMode(uint16_t rotation, uint16_t color, bool showSelected, int stageSelected);
+void printStageLabel(int k, uint16_t color);
+void showSettings(void);
+void composeGameLabels(GameTypeView game, GameLabels& labels);
+void composeClockModeName(GameTypeView game, TFTSpanLabel& label);
+void composeClockDelay(GameTypeView game, TFTSpanLabel& label);
+void composeStageData(GameTypeView game, int k, TFTSpanLabel& label);
+int settingsCellGame(int i, int j);
+bool settingsCellOf(int gameIndex, int& i, int& j);
+void paintSettingCell(int i, int j);
+void paintGameCell(int i, int j, const GameLabels& labels);
+void paintPageCell(int i, int j);
+void paintSettings();
+void flipSettingsPage();
+void paintSettingsRow(uint16_t row);
+void clearScreen(uint16_t color);
+void paintClocks(uint16_t);
+void paintSettingsIcon(uint16_t color);
+void paintResetIcon(uint16_t color);
+void paintPauseIcon(uint16_t color);
+void queueIcons(uint16_t pauseIconColor, uint16_t resetSettingsColor);
+void paintPawnsIcons(uint16_t);
+void drawRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color, uint16_t borderWidth);
+void setScreenRotation(const int rotation);
+PanelView& panelView(const int rotation);
+void invalidatePanels();
+void printBorder(PanelView& panel, uint16_t color);
+void printClock(PanelView& panel, const long newTime, uint16_t color, bool isSeparatorOn);
+void prepareClock(PanelView& panel, const long newTime, uint16_t color, bool isSeparatorOn);
+void printMoves(PanelView& panel, uint16_t moves, uint16_t color);
+void printDelay(PanelView& panel, uint8_t seconds, uint16_t color);
+bool separatorPhase(const long timeMillis);
+void printTime(const long newTime, const int rotation, uint16_t moves, const bool selected);
+void printPauseTime(const long newTime, const int rotation, uint16_t moves);
+void printPauseTimes();
+void paintPauseTimes(uint16_t);
+void changeSettingsSelectionTo(int newSelectedGameIndex);
+void paintSelectionCell(uint16_t gameIndex);
+void queueTouchEvents();
+TouchZone touchZone(HitZone hit);
+void layoutTouchZones(const int rotation);
+int16_t firstTouchKey(int16_t coordinate, bool isX, int16_t size);
+long touchPosition(int16_t key, bool isX, int16_t size);
+uint8_t touchBand(int16_t key, const int16_t* starts, uint8_t count);
+HitZone hitTest(int16_t rawX, int16_t rawY);
+uint16_t readUiSelection(const TouchEvent& event);
+void resetAction(const TouchEvent& event);
+void settingsAction(const TouchEvent& event);
+void selectGameAction(const TouchEvent& event);
+void startWhiteUpAction(const TouchEvent& event);
+void startWhiteDownAction(const TouchEvent& event);
+void startGame(const TouchEvent& event, bool whiteDown);
+void pauseAction(const TouchEvent& event);
+void resumeAction(const TouchEvent& event);
+void flipAction(const TouchEvent& event);
+
+typedef void (*UiActionHandler)(const TouchEvent& event);
+
+// action handlers by UiAction
+static const UiActionHandler uiActions[UI_ACTIONS] PROGMEM = {
+  nullptr, resetAction, settingsAction, selectGameAction, startWhiteUpAction,
+  startWhiteDownAction, pauseAction, resumeAction, flipAction
+};
+
+// Time keeping of both players, reports through onDisplayedTimeChanged and onFlagFell
+ClockEngine clockEngine(clockMicros);
 
-// Current display
-TFTSevenSegmentClockDisplay clockDisplay = clockDisplayMinutes ;
+// Idles between the clock events and the touch samples
+TickScheduler tickScheduler;
+uint32_t nextTouchSample = 0;
+
+// Large repaints, run in bounded units after the clock and the touch panel are served
+RenderQueue renderQueue;
 
 
 
@@ -217,285 +438,431 @@ void setup(void) {
   tft.reset();
   uint16_t identifier = tft.readID();
   tft.begin(identifier);
+  clockEngine.setDisplayResolution(SEPARATOR_BLINK_MILLIS * 1000L);
+  clockEngine.setLowTimeResolution(LOW_TIME_MILLIS * 1000L, TENTH_MILLIS * 1000L);
+  clockEngine.setDisplayChangedHandler(onDisplayedTimeChanged);
+  clockEngine.setFlagFellHandler(onFlagFell);
+  clockEngine.setDelayChangedHandler(onDelayChanged);
+  tickScheduler.begin();
+  touchSampler.begin();
+  layoutTouchZones(INITIAL_ROTATION);
+  stagesTitle.append(F("STG"));
   resetGame();
 }
 
 void loop(void) {
-  readUiSelection();
-  if (state == WHITE_PLAYING) {
-    whiteClockLoop();
-  } else if (state == BLACK_PLAYING) {
-    blackClockLoop();
+  // first give the shared pins back to the LCD, a conversion may still hold them
+  if (touchSampler.collect()) {
+    queueTouchEvents();
+  }
+  {
+    PROFILE_SCOPE(PROFILE_CLOCK);
+    clockEngine.update(); // a boundary reached while sleeping is drawn before the touch work
+  }
+  TouchEvent event;
+  while (touchEvents.pop(event)) {
+    readUiSelection(event);
+  }
+  if ((int32_t)(clockMicros() - nextTouchSample) >= 0) {
+    nextTouchSample = clockMicros() + TOUCH_SAMPLE_MILLIS * 1000L;
+    touchSampler.start();
+  }
+  renderQueue.run();
+#if defined(CHESSCLOCK_PROFILE)
+  Profiler::poll();
+#endif
+  touchSampler.convert(); // the conversion runs while the CPU idles, or while the queue draws
+  if (renderQueue.isEmpty()) {
+    tickScheduler.sleepUntil(nextDeadline());
   }
 }
 
+// earliest of the next touch sample, the touch conversion and the next clock event
+uint32_t nextDeadline() {
+  uint32_t deadline = nextTouchSample;
+  uint32_t event;
+  if (clockEngine.nextEventTime(event) && (int32_t)(event - deadline) < 0) {
+    deadline = event;
+  }
+  if (touchSampler.nextStepTime(event) && (int32_t)(event - deadline) < 0) {
+    deadline = event;
+  }
+  return deadline;
+}
 
+uint32_t clockMicros() {
+  return micros();
+}
 
-void whiteClockLoop() {
-  if (isNewTurn && (currentGame.incrementType == DELAY)
-      && ((millis() - whitesTurnInitMillis) < currentGame.incrementSeconds * 1000 )) {
-    if ((millis() - whitesTurnInitMillis) / 1000 % 10 == 0) {
-      printTime(whitesTimeMillis, whitesRotation, whitesmoves, true);
-      printTime(blacksTimeMillis, blacksRotation, blacksmoves, false);
-    }
-    // wait delay
-    return;
-  } else if (isNewTurn && (currentGame.incrementType == DELAY)) {
-    whitesTurnInitMillis = millis();
-    whitesEllapsedTimeMillis = millis();
-  }
-
-  whitesTimeMillis = whitesTimeMillis - (millis() - whitesEllapsedTimeMillis );
-  unsigned long whitesTime = whitesTimeMillis / 1000;
-  whitesEllapsedTimeMillis = millis();
-  if (whitesTime > 0 ) {
-    if (whitesOldTimeMillis / 1000 != whitesTime || isNewTurn) {
-      if (isNewTurn) {
-        printTime(blacksTimeMillis, blacksRotation, blacksmoves, false);
-      }
-      printTime(whitesTimeMillis, whitesRotation, whitesmoves, true);
-      whitesOldTimeMillis = whitesTimeMillis;
-      isNewTurn = false;
-    }
-  } else {
-    if (currentGame.stagesNumber > 1 && currentStageWhites < 2 ) {
-      if ( whitesStageMoves > currentGame.stages[currentStageWhites].moves) {
-        whitesStageMoves = 0;
-        ++currentStageWhites;
-        whitesTimeMillis = currentGame.stages[currentStageWhites].duration * 1000;
-      } else {
-        state = END_GAME;
-        printTime(0, blacksRotation, blacksmoves, true);
-      }
-    } else {
-      state = END_GAME;
-      printTime(0, whitesRotation, whitesmoves, true);
-    }
+// remaining time as shown, rounded up to the second, or to the tenth in low time
+long displayMillis(const ClockMicros remaining) {
+  if (remaining <= LOW_TIME_MILLIS * 1000L) {
+    return (remaining + TENTH_MILLIS * 1000L - 1) / (TENTH_MILLIS * 1000L) * TENTH_MILLIS;
   }
+  return remaining / 1000 + 999;
 }
 
-void blackClockLoop() {
-  if (isNewTurn && (currentGame.incrementType == DELAY)
-      && ((millis() - blacksTurnInitMillis) < currentGame.incrementSeconds * 1000 )) {
-    // wait delay
-    if ((millis() - blacksTurnInitMillis) / 1000 % 10 == 0) {
-      printTime(whitesTimeMillis, whitesRotation, whitesmoves, false);
-      printTime(blacksTimeMillis, blacksRotation, blacksmoves, true);
-    }
-    return;
-  } else if (isNewTurn && (currentGame.incrementType == DELAY)) {
-    blacksTurnInitMillis = millis();
-    blacksEllapsedTimeMillis = millis();
-  }
-
-  blacksTimeMillis = blacksTimeMillis - (millis() - blacksEllapsedTimeMillis );
-  unsigned long blacksTime = blacksTimeMillis / 1000;
-  blacksEllapsedTimeMillis = millis();
-  if (blacksTime > 0  ) {
-    if ( blacksOldTimeMillis / 1000 != blacksTime || isNewTurn) {
-      if (isNewTurn) {
-        printTime(whitesTimeMillis, whitesRotation, whitesmoves, false);
-      }
-      printTime(blacksTimeMillis, blacksRotation, blacksmoves, true);
-      blacksOldTimeMillis = blacksTimeMillis;
-      isNewTurn = false;
-    }
-  } else {
-    if (currentGame.stagesNumber > 1 && currentStageBlacks < 2 ) {
-      if (blacksStageMoves > currentGame.stages[currentStageBlacks].moves) {
-        blacksStageMoves = 0;
-        ++currentStageBlacks;
-        blacksTimeMillis = currentGame.stages[currentStageBlacks].duration * 1000;
-      } else {
-        state = END_GAME;
-        printTime(0, blacksRotation, blacksmoves, true);
-      }
-    } else {
-      state = END_GAME;
-      printTime(0, blacksRotation, blacksmoves, true);
-    }
+uint16_t playerRotation(uint8_t player) {
+  return player == ClockEngine::WHITES ? whitesRotation : blacksRotation;
+}
+
+void onDisplayedTimeChanged(uint8_t player, ClockMicros remaining) {
+  // the boundary the clock was prepared for has been crossed, its time is known
+  const bool isPrepared = preparedClock.isReady && preparedClock.player == player
+                          && remaining <= preparedClock.boundary
+                          && remaining > clockEngine.nextDisplayChange((ClockEngine::Player) player);
+  isBoundaryPending = true;
+  printTime(isPrepared ? preparedClock.time : displayMillis(remaining), playerRotation(player),
+            clockEngine.moves((ClockEngine::Player) player), true);
+  isBoundaryPending = false;
+  prepareNextClock(player);
+}
+
+// compute the clock the next boundary shows, while there is time to spare
+void prepareNextClock(uint8_t player) {
+  const ClockMicros boundary = clockEngine.nextDisplayChange((ClockEngine::Player) player);
+  if (boundary <= 0) {
+    return; // the flag falls next
   }
+  const long nextTime = displayMillis(boundary);
+  prepareClock(panelView(playerRotation(player)), nextTime, foregroundColor, separatorPhase(nextTime));
+  preparedClock.player = player;
+  preparedClock.boundary = boundary;
 }
 
+// pixels of a clock change are about to be pushed, account the latency from its boundary
+void markFirstPixel() {
+  if (isBoundaryPending) {
+    boundaryLatency.record(clockMicros() - clockEngine.lastEventTime());
+    isBoundaryPending = false;
+  }
+}
 
+void onFlagFell(uint8_t player, ClockMicros remaining) {
+  flagFellState = state;
+  state = END_GAME;
+  isBoundaryPending = true;
+  printTime(0, playerRotation(player), clockEngine.moves((ClockEngine::Player) player), true);
+  isBoundaryPending = false;
+}
 
-void resetGame(void) {
-  PROGMEMData (&games[selectedGameIndex], currentGame);
+// only the countdown changes during the US delay, the clock stays frozen
+void onDelayChanged(uint8_t player, ClockMicros delayLeft) {
+  const uint16_t rotation = playerRotation(player);
+  setScreenRotation(rotation);
+  printDelay(panelView(rotation), (delayLeft + MICROS_IN_SECOND - 1) / MICROS_IN_SECOND, foregroundColor);
+  setScreenRotation(INITIAL_ROTATION);
+}
 
-  if (currentGame.stages[0].duration + currentGame.incrementSeconds >= 3600) {
-    clockDisplay = clockDisplayHours;
-  } else {
-    clockDisplay = clockDisplayMinutes;
+// US delay left in whole seconds if the panel belongs to the player on move
+uint8_t panelDelaySeconds(const int rotation) {
+  if (rotation != playerRotation(clockEngine.onMove())) {
+    return 0;
   }
-  whitesmoves = 0;
-  blacksmoves = 0;
-  whitesStageMoves = 0;
-  blacksStageMoves = 0;
-
-  currentStageWhites = 0;
-  currentStageBlacks = 0;
+  return (clockEngine.delayRemaining() + MICROS_IN_SECOND - 1) / MICROS_IN_SECOND;
+}
 
-  Serial.println("RESET");
-  state = IDLE;
-  tft.fillScreen(backgroundColor);
+// repaint both clocks, the player on move highlighted
+void printClocks() {
+  printTime(displayMillis(clockEngine.remaining(ClockEngine::WHITES)), whitesRotation,
+            clockEngine.moves(ClockEngine::WHITES), state == WHITE_PLAYING);
+  printTime(displayMillis(clockEngine.remaining(ClockEngine::BLACKS)), blacksRotation,
+            clockEngine.moves(ClockEngine::BLACKS), state == BLACK_PLAYING);
+  if (clockEngine.isRunning()) {
+    prepareNextClock(clockEngine.onMove());
+  }
+}
 
-  isNewTurn = false;
 
-  whitesTimeMillis = currentGame.stages[0].duration * 1000 + 999;
-  whitesOldTimeMillis = whitesTimeMillis;
-  whitesTurnInitMillis = millis();
-  whitesEllapsedTimeMillis = millis();
 
+void resetGame(void) {
+  GameType game;
+  PROGMEMData (&games[selectedGameIndex], game);
+  clockEngine.reset(game);
+  composeGameLabels(GameTypeView(&games[selectedGameIndex]), gameLabels);
 
-  blacksTimeMillis = currentGame.stages[0].duration * 1000 + 999;
-  blacksOldTimeMillis = blacksTimeMillis;
-  blacksTurnInitMillis = millis();
-  blacksEllapsedTimeMillis = millis();
+  if (game.stages[0].duration + game.incrementSeconds >= 3600) {
+    clockDisplay = &clockDisplayHours;
+  } else {
+    clockDisplay = &clockDisplayMinutes;
+  }
 
-  clockDisplay.setOffColor(backgroundColor);
-  printTime(whitesTimeMillis, whitesRotation, 0, false);
-  printTime(blacksTimeMillis, blacksRotation, 0, false);
-  printClockMode(foregroundColor);
-  paintResetSettingsIcons(foregroundColor);
+  Serial.println("RESET");
+#if defined(CHESSCLOCK_PROFILE)
+  Profiler::reset(); // each game is profiled on its own
+#endif
+  state = IDLE;
+  renderQueue.clear(); // the page being drawn is gone
+  clockDisplay->invalidate();
+  preparedClock.isReady = false;
+  movesDisplay.invalidate();
+  delayDisplay.invalidate();
+
+  clockDisplay->setOffColor(backgroundColor);
+  renderQueue.push(clearScreen, backgroundColor);
+  renderQueue.push(paintClocks, 0);
+  renderQueue.push(printClockMode, foregroundColor);
+  renderQueue.push(paintSettingsIcon, foregroundColor);
+  renderQueue.push(paintResetIcon, foregroundColor);
+}
 
+// paint the whole screen, the panels on it are gone
+void clearScreen(uint16_t color) {
+  setScreenRotation(INITIAL_ROTATION);
+  tft.fillScreen(color);
+  invalidatePanels();
+}
 
+// render queue unit of printClocks
+void paintClocks(uint16_t) {
+  printClocks();
 }
 
 void printClockMode(uint16_t color) {
-  printClockMode(whitesRotation, color, state == WHITE_PLAYING, currentStageWhites);
-  printClockMode(blacksRotation, color, state == BLACK_PLAYING, currentStageBlacks);
+  printClockMode(whitesRotation, color, state == WHITE_PLAYING, clockEngine.stage(ClockEngine::WHITES));
+  printClockMode(blacksRotation, color, state == BLACK_PLAYING, clockEngine.stage(ClockEngine::BLACKS));
 }
 
 void printStages(int16_t x, int16_t y, uint16_t color, bool showSelected, int stageSelected) {
-  tft.setCursor(x, y);
-  tft.print("STG");
-  for (int k = 0; k < currentGame.stagesNumber; k++) {
-    printStageData(currentGame, x + 26 + k * 60 , y, k, (k == stageSelected && showSelected) ? foregroundColor : color);
+  stagesTitle.draw(&tft, x, y, color);
+  for (int k = 0; k < clockEngine.game().stagesNumber; k++) {
+    gameLabels.stages[k].draw(&tft, x + 26 + k * 60, y, (k == stageSelected && showSelected) ? foregroundColor : color);
   }
-  tft.setTextColor(color);
 }
 
 void printClockMode(uint16_t rotation, uint16_t color, bool showSelected, int stageSelected) {
-  tft.setRotation(rotation);
-  printClockModeName(currentGame, 16, tft.height() - PLAYER_CLOCK_HEIGHT + 8, color);
-  printClockDelay(currentGame, 80, tft.height() - PLAYER_CLOCK_HEIGHT + 8 , color);
+  PanelView& panel = panelView(rotation);
+  const int highlightedStage = showSelected ? stageSelected : NO_STAGE;
+  if (!(panel.dirty & LABELS_WIDGET) && panel.labelColor == color) {
+    if (panel.highlightedStage != highlightedStage) {
+      // labels are already there, only the highlighted stage moves
+      TFTBusTransaction::begin(&tft);
+      setScreenRotation(rotation);
+      printStageLabel(panel.highlightedStage, color);
+      printStageLabel(highlightedStage, foregroundColor);
+      setScreenRotation(INITIAL_ROTATION);
+      TFTBusTransaction::end(&tft);
+      panel.highlightedStage = highlightedStage;
+    }
+    return;
+  }
+  TFTBusTransaction::begin(&tft);
+  setScreenRotation(rotation);
+  gameLabels.modeName.draw(&tft, 16, tft.height() - PLAYER_CLOCK_HEIGHT + 8, color);
+  gameLabels.delay.draw(&tft, 80, tft.height() - PLAYER_CLOCK_HEIGHT + 8, color);
   printStages(16, tft.height() - 27, color, showSelected, stageSelected);
-  tft.setRotation(INITIAL_ROTATION);
+  setScreenRotation(INITIAL_ROTATION);
+  TFTBusTransaction::end(&tft);
+  panel.labelColor = color;
+  panel.highlightedStage = highlightedStage;
+  panel.dirty &= ~LABELS_WIDGET;
+}
+
+void printStageLabel(int k, uint16_t color) {
+  if (k >= 0 && k < clockEngine.game().stagesNumber) {
+    gameLabels.stages[k].draw(&tft, 16 + 26 + k * 60, tft.height() - 27, color);
+  }
 }
 
 void showSettings(void) {
   state = SETTINGS;
+  // open the page of the game being played, gameLabels already hold its cell
+  settingsPage = selectedGameIndex / gamesPerPage;
   paintSettings();
 }
 
-void printClockModeName (GameType game, int16_t x, int16_t y, uint16_t color) {
-  tft.setTextColor(color);
-  tft.setCursor(x, y);
-  if (game.incrementType == DELAY) {
-    tft.print(F("US DELAY") );
-  } else if (game.incrementType == BRONSTEIN) {
-    tft.print(F("BRONSTEIN") );
-  } else if (game.incrementType == FISCHER) {
-    if (game.incrementSeconds == 0) {
-      tft.print(F("TIME") );
+void composeGameLabels(GameTypeView game, GameLabels& labels) {
+  composeClockModeName(game, labels.modeName);
+  composeClockDelay(game, labels.delay);
+  const uint16_t stagesNumber = game.stagesNumber();
+  for (unsigned int k = 0; k < countof(labels.stages); k++) {
+    if (k < stagesNumber) {
+      composeStageData(game, k, labels.stages[k]);
+    } else {
+      labels.stages[k].clear();
+    }
+  }
+}
+
+void composeClockModeName(GameTypeView game, TFTSpanLabel& label) {
+  label.clear();
+  const IncrementType incrementType = game.incrementType();
+  if (incrementType == DELAY) {
+    label.append(F("US DELAY"));
+  } else if (incrementType == BRONSTEIN) {
+    label.append(F("BRONSTEIN"));
+  } else if (incrementType == FISCHER) {
+    if (game.incrementSeconds() == 0) {
+      label.append(F("TIME"));
     } else {
-      tft.print(F("FISCHER") );
+      label.append(F("FISCHER"));
     }
   }
 }
 
-void printClockDelay(GameType game, int16_t x, int16_t y, uint16_t color) {
-  tft.setCursor(x, y);
-  if (game.incrementSeconds > 0) {
-    tft.print(F("INC ") ); tft.print(game.incrementSeconds); tft.print(F("s") );
+void composeClockDelay(GameTypeView game, TFTSpanLabel& label) {
+  label.clear();
+  const uint16_t incrementSeconds = game.incrementSeconds();
+  if (incrementSeconds > 0) {
+    label.append(F("INC ")); label.append(incrementSeconds); label.append('s');
   }
 }
 
-void printStageData(GameType game, int16_t x, int16_t y, int k, uint16_t color) {
-  tft.setCursor(x, y);
-  tft.setTextColor(color);
-  if (game.stages[k].duration / 60 > 0) {
-    tft.print(game.stages[k].duration / 60  );
-    tft.print(F("m" ));
+void composeStageData(GameTypeView game, int k, TFTSpanLabel& label) {
+  const StageTypeView stage = game.stage(k);
+  const long duration = stage.duration();
+  const int moves = stage.moves();
+  label.clear();
+  if (duration / 60 > 0) {
+    label.append((uint16_t)(duration / 60));
+    label.append('m');
   } else {
-    tft.print(game.stages[k].duration   );
-    tft.print(F("s" ));
+    label.append((uint16_t) duration);
+    label.append('s');
   }
-  if (game.stages[k].moves > 0) {
-    tft.print(F("/" ));
-    tft.print(game.stages[k].moves);
-    tft.print(F("mv" ));
+  if (moves > 0) {
+    label.append('/');
+    label.append((uint16_t) moves);
+    label.append(F("mv"));
+  }
+}
+
+// game shown by a cell of the current page, -1 for the page cell and the empty ones
+int settingsCellGame(int i, int j) {
+  const int cell = j * settingsCols + i;
+  const int gameIndex = settingsPage * gamesPerPage + cell;
+  return cell < gamesPerPage && gameIndex < gamesNumber ? gameIndex : -1;
+}
+
+// cell of a game, false if it is not on the current page
+bool settingsCellOf(int gameIndex, int& i, int& j) {
+  const int cell = gameIndex - settingsPage * gamesPerPage;
+  if (cell < 0 || cell >= gamesPerPage) {
+    return false;
   }
+  i = cell % settingsCols;
+  j = cell / settingsCols;
+  return true;
 }
 
 void paintSettingCell(int i, int j) {
-  int cellWidth = tft.width() / settingsCols;
-  int cellHeight = tft.height() / settingsRows;
+  const int gameIndex = settingsCellGame(i, j);
+  if (gameIndex == selectedGameIndex) {
+    paintGameCell(i, j, gameLabels);
+  } else if (gameIndex >= 0) {
+    GameLabels labels;
+    composeGameLabels(GameTypeView(&games[gameIndex]), labels);
+    paintGameCell(i, j, labels);
+  } else if (settingsPages > 1 && j * settingsCols + i == gamesPerPage) {
+    paintPageCell(i, j);
+  }
+}
 
-  int gameIndex = j * settingsCols + i;
-  tft.drawRect(i * cellWidth, j * cellHeight, cellWidth, cellHeight, CYAN);
-  GameType game;
-  PROGMEMData (&games [gameIndex], game);
-  printClockModeName(game, i * cellWidth + 2, j * cellHeight + 2, WHITE);
-  printClockDelay(game, i * cellWidth + 2, j * cellHeight + 2 + 9, WHITE);
+void paintGameCell(int i, int j, const GameLabels& labels) {
+  const int cellWidth = tft.width() / settingsCols;
+  const int cellHeight = tft.height() / settingsRows;
+  const int16_t x = i * cellWidth + 2;
+  const int16_t y = j * cellHeight + 2;
 
-  for (int k = 0; k < game.stagesNumber; k++) {
-    printStageData(game, i * cellWidth + 2, j * cellHeight + 2 + 18 + 9 * k, k, WHITE);
+  tft.drawRect(i * cellWidth, j * cellHeight, cellWidth, cellHeight, CYAN);
+  labels.modeName.draw(&tft, x, y, WHITE);
+  labels.delay.draw(&tft, x, y + 9, WHITE);
+  for (unsigned int k = 0; k < countof(labels.stages); k++) {
+    labels.stages[k].draw(&tft, x, y + 18 + 9 * k, WHITE);
   }
 }
 
+// the last cell flips to the next page
+void paintPageCell(int i, int j) {
+  const int cellWidth = tft.width() / settingsCols;
+  const int cellHeight = tft.height() / settingsRows;
+
+  tft.drawRect(i * cellWidth, j * cellHeight, cellWidth, cellHeight, CYAN);
+  TFTSpanLabel label;
+  label.append(F("NEXT"));
+  label.draw(&tft, i * cellWidth + 2, j * cellHeight + 2, WHITE);
+  label.clear();
+  label.append(F("PAGE "));
+  label.append((uint16_t)(settingsPage + 1));
+  label.append('/');
+  label.append((uint16_t) settingsPages);
+  label.draw(&tft, i * cellWidth + 2, j * cellHeight + 2 + 9, WHITE);
+}
+
+// queue the settings page, a screen clear and then a unit per row of cells
 void paintSettings() {
-  tft.setRotation(INITIAL_ROTATION);
-  tft.fillScreen(backgroundColor);
+  renderQueue.clear();
+  renderQueue.push(clearScreen, backgroundColor);
+  for (int j = 0; j < settingsRows; ++j) {
+    renderQueue.push(paintSettingsRow, j);
+  }
+}
 
+// show the next page, the panels are gone so each row clears its own band
+void flipSettingsPage() {
+  settingsPage = (settingsPage + 1) % settingsPages;
+  renderQueue.clear();
+  for (int j = 0; j < settingsRows; ++j) {
+    renderQueue.push(paintSettingsRow, j | SETTINGS_ROW_CLEAR);
+  }
+}
+
+void paintSettingsRow(uint16_t arg) {
+  PROFILE_SCOPE(PROFILE_SETTINGS);
+  const int row = arg & ~SETTINGS_ROW_CLEAR;
+  setScreenRotation(INITIAL_ROTATION);
   int cellWidth = tft.width() / settingsCols;
   int cellHeight = tft.height() / settingsRows;
-  tft.fillRect(selectedGameIndex % settingsCols * cellWidth, selectedGameIndex / settingsCols * cellHeight, cellWidth, cellHeight, BLACK);
-  for (int j = 0; j < settingsRows; ++j) {
-    for (int i = 0; i < settingsCols; ++i) {
-      paintSettingCell(i, j);
+  if (arg & SETTINGS_ROW_CLEAR) {
+    tft.fillRect(0, row * cellHeight, tft.width(), cellHeight, backgroundColor);
+  }
+  for (int i = 0; i < settingsCols; ++i) {
+    if (settingsCellGame(i, row) == selectedGameIndex) {
+      tft.fillRect(i * cellWidth, row * cellHeight, cellWidth, cellHeight, BLACK);
     }
+    paintSettingCell(i, row);
   }
 }
 
 
 
 void paintSettingsIcon(uint16_t color) {
-  tft.drawBitmap(tft.width() / 2 - 96, tft.height() / 2 - 16, epd_bitmap_settings, 32, 32, color);
+  TFTIconBlitter::draw(&tft, tft.width() / 2 - 96, tft.height() / 2 - 16, rle_icon_settings, color);
 }
 
 void paintResetIcon(uint16_t color) {
-  tft.drawBitmap(tft.width() / 2 + 64, tft.height() / 2 - 16, epd_bitmap_reset, 32, 32, color);
-}
-
-void paintResetSettingsIcons(uint16_t color) {
-  paintSettingsIcon(color);
-  paintResetIcon(color);
-
+  TFTIconBlitter::draw(&tft, tft.width() / 2 + 64, tft.height() / 2 - 16, rle_icon_reset, color);
 }
 
 void paintPauseIcon(uint16_t color) {
 
-  tft.drawBitmap(tft.width() / 2 - 16, tft.height() / 2 - 16, epd_bitmap_pause, 32, 32, color);
+  TFTIconBlitter::draw(&tft, tft.width() / 2 - 16, tft.height() / 2 - 16, rle_icon_pause, color);
 
 }
 
-void paintPawnsIcons() {
+// the middle strip icons after a state change, one render unit each
+void queueIcons(uint16_t pauseIconColor, uint16_t resetSettingsColor) {
+  renderQueue.push(paintPauseIcon, pauseIconColor);
+  renderQueue.push(paintSettingsIcon, resetSettingsColor);
+  renderQueue.push(paintResetIcon, resetSettingsColor);
+}
 
-  tft.setRotation(blacksRotation);
-  tft.drawBitmap(tft.width() - 26, tft.height() - 34, epd_bitmap_pawn , 16, 16, BLACK);
+void paintPawnsIcons(uint16_t) {
 
-  tft.setRotation(whitesRotation);
-  tft.drawBitmap(tft.width() - 26, tft.height() - 34, epd_bitmap_pawn, 16, 16, WHITE);
+  setScreenRotation(blacksRotation);
+  TFTIconBlitter::draw(&tft, tft.width() - 26, tft.height() - 34, rle_icon_pawn, BLACK);
 
-  tft.setRotation(INITIAL_ROTATION);
+  setScreenRotation(whitesRotation);
+  TFTIconBlitter::draw(&tft, tft.width() - 26, tft.height() - 34, rle_icon_pawn, WHITE);
+
+  setScreenRotation(INITIAL_ROTATION);
 }
 
 
 
 void drawRect(int16_t x, int16_t y, int16_t w, int16_t h,
               uint16_t color, uint16_t borderWidth) {
-  tft.startWrite();
+  TFTBusTransaction::begin(&tft);
   for (uint16_t i = 0; i < borderWidth; i++) {
     tft.writeFastHLine(x + i, y + i, w - 2 * i, color);
     tft.writeFastHLine(x + i, y + h - 1 - i, w - 2 * i, color);
@@ -503,225 +870,406 @@ void drawRect(int16_t x, int16_t y, int16_t w, int16_t h,
     tft.writeFastVLine(x + w - 1 - i, y + i, h - 2 * i, color);
 
   }
-  tft.endWrite();
+  TFTBusTransaction::end(&tft);
 }
 
+// setRotation always talks to the controller, skip it when nothing changes
+void setScreenRotation(const int rotation) {
+  if (tft.getRotation() != rotation) {
+    tft.setRotation(rotation);
+  }
+}
 
-void printTime(const long newTime, const int rotation, uint16_t moves, const bool selected) {
-  static bool toggleSeparator;
-  toggleSeparator = !toggleSeparator;
-  tft.setRotation(rotation);
-  int16_t  x1, y1;
-  uint16_t w, h;
+PanelView& panelView(const int rotation) {
+  return panels[rotation == INITIAL_ROTATION ? 0 : 1];
+}
 
-  if (selected) {
-    if (newTime == 0) {
-      drawRect(5 , (int) tft.height() - PLAYER_CLOCK_HEIGHT, tft.width() - 10, PLAYER_CLOCK_HEIGHT - 10, alertColor, 5);
-      clockDisplay.setOnColor( alertColor);
-      movesDisplay.setOnColor(alertColor);
+// the screen has been cleared, every widget must be painted again
+void invalidatePanels() {
+  for (unsigned int i = 0; i < countof(panels); i++) {
+    panels[i].dirty = ALL_WIDGETS;
+  }
+}
 
-    } else {
-      drawRect(5 , (int) tft.height() - PLAYER_CLOCK_HEIGHT, tft.width() - 10, PLAYER_CLOCK_HEIGHT - 10, tft.color565(255, 255, 0), 5);
-      clockDisplay.setOnColor(foregroundColor);
-      movesDisplay.setOnColor(foregroundColor);
+void printBorder(PanelView& panel, uint16_t color) {
+  if (!(panel.dirty & BORDER_WIDGET) && panel.borderColor == color) {
+    return;
+  }
+  drawRect(5 , (int) tft.height() - PLAYER_CLOCK_HEIGHT, tft.width() - 10, PLAYER_CLOCK_HEIGHT - 10, color, 5);
+  panel.borderColor = color;
+  panel.dirty &= ~BORDER_WIDGET;
+}
+
+void printClock(PanelView& panel, const long newTime, uint16_t color, bool isSeparatorOn) {
+  if (!preparedClock.isReady || preparedClock.panel != &panel || preparedClock.time != newTime
+      || preparedClock.color != color || preparedClock.isSeparatorOn != isSeparatorOn) {
+    prepareClock(panel, newTime, color, isSeparatorOn);
+  }
+  preparedClock.isReady = false;
+  if (!(panel.dirty & CLOCK_WIDGET) && panel.clockUnits == preparedClock.units
+      && panel.clockTenths == preparedClock.isLowTime && panel.clockColor == color) {
+    if (!preparedClock.isLowTime) {
+      clockDisplay->displaySeparator(isSeparatorOn);
     }
+    return;
+  }
+  markFirstPixel();
+  clockDisplay->commitPrepared();
+  panel.clockUnits = preparedClock.units;
+  panel.clockTenths = preparedClock.isLowTime;
+  panel.clockColor = color;
+  panel.dirty &= ~CLOCK_WIDGET;
+}
+
+// compute what the clock shows, commitPrepared() draws it
+void prepareClock(PanelView& panel, const long newTime, uint16_t color, bool isSeparatorOn) {
+  // low time shows S.T and refreshes ten times a second, only the tenths digit changes
+  const bool isLowTime = newTime <= LOW_TIME_MILLIS;
+  clockDisplay->setOnColor(color);
+  if (isLowTime) {
+    clockDisplay->prepareTenths(newTime);
   } else {
-    drawRect(5 , (int) tft.height() - PLAYER_CLOCK_HEIGHT, tft.width() - 10, PLAYER_CLOCK_HEIGHT - 10, tft.color565(0, 0, 0), 5);
-    clockDisplay.setOnColor(BLACK);
-    movesDisplay.setOnColor(BLACK);
+    clockDisplay->prepareMillis(newTime, isSeparatorOn);
+  }
+  preparedClock.isReady = true;
+  preparedClock.panel = &panel;
+  preparedClock.time = newTime;
+  preparedClock.color = color;
+  preparedClock.isSeparatorOn = isSeparatorOn;
+  preparedClock.units = isLowTime ? newTime / TENTH_MILLIS : newTime / 1000;
+  preparedClock.isLowTime = isLowTime;
+}
+
+void printMoves(PanelView& panel, uint16_t moves, uint16_t color) {
+  movesDisplay.setOnColor(color);
+  if (!(panel.dirty & MOVES_WIDGET) && panel.moves == moves && panel.movesColor == color) {
+    return;
   }
-  clockDisplay.displayMillis(newTime, toggleSeparator || !selected);
   movesDisplay.display(moves);
+  panel.moves = moves;
+  panel.movesColor = color;
+  panel.dirty &= ~MOVES_WIDGET;
+}
+
+void printDelay(PanelView& panel, uint8_t seconds, uint16_t color) {
+  if (!(panel.dirty & DELAY_WIDGET) && panel.delaySeconds == seconds && (seconds == 0 || panel.delayColor == color)) {
+    return;
+  }
+  delayDisplay.setOnColor(color);
+  delayDisplay.display(seconds);
+  panel.delaySeconds = seconds;
+  panel.delayColor = color;
+  panel.dirty &= ~DELAY_WIDGET;
+}
+
+
+bool separatorPhase(const long timeMillis) {
+  return (timeMillis / SEPARATOR_BLINK_MILLIS) % 2;
+}
+
+void printTime(const long newTime, const int rotation, uint16_t moves, const bool selected) {
+  PROFILE_SCOPE(PROFILE_PRINT_TIME);
+  // the rotation is a bus write too, take the bus before it
+  TFTBusTransaction::begin(&tft);
+  setScreenRotation(rotation);
+  PanelView& panel = panelView(rotation);
+  uint16_t borderColor = BLACK;
+  uint16_t digitsColor = BLACK;
+  if (selected) {
+    if (newTime == 0) {
+      borderColor = alertColor;
+      digitsColor = alertColor;
+    } else {
+      borderColor = tft.color565(255, 255, 0);
+      digitsColor = foregroundColor;
+    }
+  }
+
+  // border, clock and moves counter share one bus transaction
+  clockDisplay->beginFrame();
+  printBorder(panel, borderColor);
+  printClock(panel, newTime, digitsColor, separatorPhase(newTime) || !selected);
+  printMoves(panel, moves, digitsColor);
+  printDelay(panel, panelDelaySeconds(rotation), digitsColor);
+  clockDisplay->commitFrame();
   printClockMode(BLACK);
-  tft.setRotation(INITIAL_ROTATION);
+  setScreenRotation(INITIAL_ROTATION);
+  TFTBusTransaction::end(&tft);
 }
 
 
 void printPauseTime(const long newTime, const int rotation, uint16_t moves) {
-  tft.setRotation(rotation);
-  int16_t  x1, y1;
-  uint16_t w, h;
+  PROFILE_SCOPE(PROFILE_PRINT_PAUSE_TIME);
+  TFTBusTransaction::begin(&tft);
+  setScreenRotation(rotation);
+  PanelView& panel = panelView(rotation);
+
+  clockDisplay->beginFrame();
+  printClock(panel, newTime, pauseColor, true);
+  printMoves(panel, moves, pauseColor);
+  printDelay(panel, panelDelaySeconds(rotation), pauseColor);
+  clockDisplay->commitFrame();
+  printClockMode(BLACK);
+  setScreenRotation(INITIAL_ROTATION);
+  TFTBusTransaction::end(&tft);
+}
 
-  clockDisplay.setOnColor(pauseColor);
-  movesDisplay.setOnColor(pauseColor);
+void printPauseTimes() {
+  printPauseTime(displayMillis(clockEngine.remaining(ClockEngine::WHITES)), whitesRotation, clockEngine.moves(ClockEngine::WHITES));
+  printPauseTime(displayMillis(clockEngine.remaining(ClockEngine::BLACKS)), blacksRotation, clockEngine.moves(ClockEngine::BLACKS));
+}
 
-  clockDisplay.displayMillis(newTime, true);
-  movesDisplay.display(moves);
-  printClockMode(BLACK);
-  tft.setRotation(INITIAL_ROTATION);
+// render queue unit of printPauseTimes
+void paintPauseTimes(uint16_t) {
+  printPauseTimes();
 }
 
+// only the two cells change, the old one is redrawn from the cached labels and
+// only the new one is composed
 void changeSettingsSelectionTo(int newSelectedGameIndex) {
-  tft.setRotation(INITIAL_ROTATION);
+  if (!renderQueue.isEmpty()) {
+    // the page is still being drawn, both cells are repainted behind it
+    const int oldSelectedGameIndex = selectedGameIndex;
+    selectedGameIndex = newSelectedGameIndex;
+    composeGameLabels(GameTypeView(&games[selectedGameIndex]), gameLabels);
+    renderQueue.push(paintSelectionCell, oldSelectedGameIndex);
+    renderQueue.push(paintSelectionCell, selectedGameIndex);
+    return;
+  }
+  setScreenRotation(INITIAL_ROTATION);
   int cellWidth = tft.width() / settingsCols;
   int cellHeight = tft.height() / settingsRows;
+  int i, j;
 
-  tft.fillRect(selectedGameIndex % settingsCols * cellWidth, selectedGameIndex / settingsCols * cellHeight, cellWidth, cellHeight, backgroundColor);
-  paintSettingCell(selectedGameIndex % settingsCols, selectedGameIndex / settingsCols);
-
-  tft.fillRect(newSelectedGameIndex % settingsCols * cellWidth, newSelectedGameIndex / settingsCols * cellHeight, cellWidth, cellHeight, BLACK);
-  paintSettingCell(newSelectedGameIndex % settingsCols, newSelectedGameIndex / settingsCols);
+  if (settingsCellOf(selectedGameIndex, i, j)) {
+    tft.fillRect(i * cellWidth, j * cellHeight, cellWidth, cellHeight, backgroundColor);
+    paintGameCell(i, j, gameLabels);
+  }
 
   selectedGameIndex = newSelectedGameIndex;
+  composeGameLabels(GameTypeView(&games[selectedGameIndex]), gameLabels);
+  if (settingsCellOf(selectedGameIndex, i, j)) {
+    tft.fillRect(i * cellWidth, j * cellHeight, cellWidth, cellHeight, BLACK);
+    paintGameCell(i, j, gameLabels);
+  }
 }
 
+// render queue unit repainting the cell of a game as selected or not
+void paintSelectionCell(uint16_t gameIndex) {
+  int i, j;
+  if (!settingsCellOf(gameIndex, i, j)) {
+    return;
+  }
+  setScreenRotation(INITIAL_ROTATION);
+  const int cellWidth = tft.width() / settingsCols;
+  const int cellHeight = tft.height() / settingsRows;
+  tft.fillRect(i * cellWidth, j * cellHeight, cellWidth, cellHeight,
+               (int) gameIndex == selectedGameIndex ? BLACK : backgroundColor);
+  paintSettingCell(i, j);
+}
 
-uint16_t readUiSelection() {
-  tft.setRotation(INITIAL_ROTATION);
-  int16_t xpos, ypos;  //screen coordinates
-  TSPoint tp = ts.getPoint();   //tp.x, tp.y are ADC values
 
-  // if sharing pins, you'll need to fix the directions of the touchscreen pins
-  pinMode(XM, OUTPUT);
-  pinMode(YP, OUTPUT);
+// turn the last reading into press and release events, stamped with the reading time
+void queueTouchEvents() {
+  const TSPoint& tp = touchSampler.point();   //tp.x, tp.y are ADC values
+  if (tp.z >= MAXPRESSURE) {
+    return; // not a finger, keep the current state
+  }
+  // pressure hysteresis, a press starts above MINPRESSURE and ends below RELEASE_PRESSURE
+  // pressure of 0 means no pressing!
+  const bool pressed = isPanelPressed ? tp.z >= RELEASE_PRESSURE : tp.z > MINPRESSURE;
+  TouchEvent event = {touchSampler.time(), TOUCH_RELEASE, tp.x, tp.y, tp.z};
+  if (!pressed) {
+    if (isPanelPressed) {
+      isPanelPressed = false;
+      touchEvents.push(event);
+    }
+    return;
+  }
+  const TouchZone zone = touchZone(hitTest(tp.x, tp.y));
+  if (isPanelPressed) {
+    if (zone == pressedZone) {
+      return;
+    }
+    // a second finger on another zone reads as the finger moving there, no release in between
+    touchEvents.push(event);
+  }
+  isPanelPressed = true;
+  pressedZone = zone;
+  event.type = TOUCH_PRESS;
+  touchEvents.push(event);
+}
 
+// zone under the finger, whatever the page: a press that changes the page does not
+// turn into a new press on the next reading
+TouchZone touchZone(HitZone hit) {
+  if (hit == HIT_TOP) {
+    return TOP_ZONE;
+  }
+  return hit == HIT_BOTTOM ? BOTTOM_ZONE : BUTTONS_ZONE;
+}
 
-  if (tp.z > MINPRESSURE && tp.z < MAXPRESSURE && millis() - lastTimeTouch > 400 ) {
-    // we have some minimum pressure we consider 'valid'
-    // pressure of 0 means no pressing!
-    //    Serial.println(F("Touch"));
-    xpos = map(tp.x, TS_RT, TS_LEFT, 0, tft.width());
-    ypos = map(tp.y, TS_BOT, TS_TOP, 0, tft.height());
+// zone limits in raw touch readings, touch coordinates are those of the rotation
+void layoutTouchZones(const int rotation) {
+  const int16_t width = rotation % 2 ? TFTHEIGHT : TFTWIDTH;
+  const int16_t height = rotation % 2 ? TFTWIDTH : TFTHEIGHT;
+  touchLayout.stripTop = firstTouchKey(PLAYER_CLOCK_HEIGHT + 1, false, height);
+  touchLayout.stripBottom = firstTouchKey(height - PLAYER_CLOCK_HEIGHT, false, height);
+  touchLayout.buttonsTop = firstTouchKey(height / 2 - 32 + 1, false, height);
+  touchLayout.buttonsBottom = firstTouchKey(height / 2 + 32, false, height);
+  touchLayout.centerLeft = firstTouchKey(width / 3, true, width);
+  touchLayout.rightLeft = firstTouchKey(2 * width / 3 + 1, true, width);
+  for (int i = 1; i < settingsCols; i++) {
+    touchLayout.columns[i - 1] = firstTouchKey(i * (width / settingsCols), true, width);
+  }
+  for (int j = 1; j < settingsRows; j++) {
+    touchLayout.rows[j - 1] = firstTouchKey(j * (height / settingsRows), false, height);
+  }
+}
 
-    lastTimeTouch = millis();
-    if (state == END_GAME) {
-      resetGame();
-      return state;
-    }
-    if (state == SETTINGS) {
-      int cellWidth = tft.width() / settingsCols;
-      int cellHeight = tft.height() / settingsRows;
-      int newSelectedGameIndex = (xpos / cellWidth)  + (ypos / cellHeight) *  settingsCols;
-      if (newSelectedGameIndex == selectedGameIndex) {
-        resetGame();
-      } else {
-        changeSettingsSelectionTo(newSelectedGameIndex);
-      }
-      return state;
+// smallest key whose screen coordinate is at least the given one, map() inverted
+// and then corrected for its truncation
+int16_t firstTouchKey(int16_t coordinate, bool isX, int16_t size) {
+  const long span = isX ? TS_LEFT - TS_RT : TS_BOT - TS_TOP;
+  const int16_t lowest = isX ? 0 : -1023;
+  const int16_t highest = isX ? 1023 : 0;
+  long key = (isX ? TS_RT : -TS_BOT) + ((long) coordinate * span + size - 1) / size;
+  if (key < lowest) {
+    key = lowest;
+  } else if (key > highest) {
+    key = highest;
+  }
+  while (touchPosition(key, isX, size) < coordinate) {
+    if (++key > highest) {
+      return 1024;
     }
+  }
+  while (key > lowest && touchPosition(key - 1, isX, size) >= coordinate) {
+    --key;
+  }
+  return key;
+}
 
-    // are we in buttons area ?
-    if ( ypos > PLAYER_CLOCK_HEIGHT && ypos < tft.height() - PLAYER_CLOCK_HEIGHT ) {
-      if (state == IDLE || (state == BLACK_IN_PAUSE || state == WHITE_IN_PAUSE) && (ypos >  tft.height() / 2 - 32) && (ypos <  tft.height() / 2 + 32)) {
-        if ( xpos <  tft.width() / 3  ) {
-          state = SETTINGS;
-          showSettings();
-          return state;
-        } else if ( xpos > 2 * tft.width() / 3  ) {
-          state = IDLE;
-          resetGame();
-          return state;
-        } else if (state == BLACK_IN_PAUSE) {
-          state = BLACK_PLAYING;
-          blacksEllapsedTimeMillis = millis();
-          paintPauseIcon(foregroundColor);
-          paintResetSettingsIcons(backgroundColor);
-          return state;
-        } else if (state == WHITE_IN_PAUSE ) {
-          state = WHITE_PLAYING;
-          whitesEllapsedTimeMillis = millis();
-          paintPauseIcon(foregroundColor);
-          paintResetSettingsIcons(backgroundColor);
-          return state;
-        }
-      } else if (state == BLACK_PLAYING) {
-        state = BLACK_IN_PAUSE;
-        printPauseTime(whitesTimeMillis, whitesRotation, whitesmoves);
-        printPauseTime(blacksTimeMillis, blacksRotation, blacksmoves);
-        paintPauseIcon(alertColor);
-        paintResetSettingsIcons(alertColor);
-        return state;
-
-      } else if (state == WHITE_PLAYING) {
-        state = WHITE_IN_PAUSE;
-        printPauseTime(whitesTimeMillis, whitesRotation, whitesmoves);
-        printPauseTime(blacksTimeMillis, blacksRotation, blacksmoves);
-        paintPauseIcon(alertColor);
-        paintResetSettingsIcons(alertColor);
-        return state;
-      }
-    }
+// screen coordinate of a key, the y keys are negated readings
+long touchPosition(int16_t key, bool isX, int16_t size) {
+  return isX ? map(key, TS_RT, TS_LEFT, 0, size) : map(-key, TS_BOT, TS_TOP, 0, size);
+}
 
-    if (state == IDLE) {
-      printClockMode(BLACK);
-      if (currentGame.incrementType == BRONSTEIN) {
-        whitesTimeMillis += (currentGame.incrementSeconds * 1000);
-      }
-      state = WHITE_PLAYING;
-      // assign white color
-      if (ypos > PLAYER_CLOCK_HEIGHT) {
-        // White down
-        isWhiteDown = true;
-        whitesRotation = 2;
-        blacksRotation = 0;
-      } else {
-        // White up
-        isWhiteDown = false;
-        whitesRotation = 0;
-        blacksRotation = 2;
-      }
-      paintPawnsIcons();
-      paintPauseIcon(foregroundColor);
-      paintResetSettingsIcons(backgroundColor);
-      isNewTurn = true;
-
-      whitesTurnInitMillis = millis();
-      whitesEllapsedTimeMillis = millis();
-      return state;
-    }
+// number of band starts at or below the key
+uint8_t touchBand(int16_t key, const int16_t* starts, uint8_t count) {
+  uint8_t band = 0;
+  while (band < count && key >= starts[band]) {
+    ++band;
+  }
+  return band;
+}
 
-    if ((state == WHITE_PLAYING) &&
-        (((ypos > PLAYER_CLOCK_HEIGHT) && !isWhiteDown )
-         || (ypos < PLAYER_CLOCK_HEIGHT) && isWhiteDown )) {
-
-      ++whitesmoves;
-      ++whitesStageMoves;
-
-      if (currentGame.incrementType == BRONSTEIN) {
-        unsigned long changeTimeMillis = millis();
-        unsigned long timeExpendedMillis = changeTimeMillis - whitesTurnInitMillis;
-        if ( timeExpendedMillis < currentGame.incrementSeconds * 1000 ) {
-          whitesTimeMillis -= (currentGame.incrementSeconds * 1000 - timeExpendedMillis) ;
-        }
-      }
-
-      state = BLACK_PLAYING;
-      if (currentGame.incrementType == BRONSTEIN) {
-        blacksTimeMillis += (currentGame.incrementSeconds * 1000);
-      }
-      if (currentGame.incrementType == FISCHER) {
-        whitesTimeMillis += (currentGame.incrementSeconds * 1000);
-      }
-      blacksTurnInitMillis = millis();
-      blacksEllapsedTimeMillis = millis();
-      isNewTurn = true;
-
-    } else if ((state == BLACK_PLAYING) &&
-               (((ypos > PLAYER_CLOCK_HEIGHT) && isWhiteDown )
-                || (ypos < PLAYER_CLOCK_HEIGHT) && !isWhiteDown )) {
-
-      state = WHITE_PLAYING;
-      if (currentGame.incrementType == BRONSTEIN) {
-        whitesTimeMillis += (currentGame.incrementSeconds * 1000);
-      }
-      if (currentGame.incrementType == FISCHER) {
-        blacksTimeMillis += (currentGame.incrementSeconds * 1000);
-      }
-      ++blacksmoves;
-      ++blacksStageMoves;
-      if (currentGame.incrementType == BRONSTEIN) {
-        unsigned long changeTimeMillis = millis();
-        unsigned long timeExpendedMillis = changeTimeMillis - blacksTurnInitMillis;
-        if ( timeExpendedMillis < currentGame.incrementSeconds * 1000 ) {
-          blacksTimeMillis -=   (currentGame.incrementSeconds * 1000 - timeExpendedMillis) ;
-        }
-      }
-      whitesTurnInitMillis = millis();
-      whitesEllapsedTimeMillis = millis();
-      isNewTurn = true;
+HitZone hitTest(int16_t rawX, int16_t rawY) {
+  const int16_t yKey = -rawY;
+  if (yKey < touchLayout.stripTop) {
+    return HIT_TOP;
+  }
+  if (yKey >= touchLayout.stripBottom) {
+    return HIT_BOTTOM;
+  }
+  const uint8_t third = rawX < touchLayout.centerLeft ? 0 : rawX < touchLayout.rightLeft ? 1 : 2;
+  const bool isButtonRow = yKey >= touchLayout.buttonsTop && yKey < touchLayout.buttonsBottom;
+  return (HitZone)((isButtonRow ? HIT_BUTTON_LEFT : HIT_STRIP_LEFT) + third);
+}
 
+uint16_t readUiSelection(const TouchEvent& event) {
+  PROFILE_SCOPE(PROFILE_UI);
+  if (event.type != TOUCH_PRESS) {
+    return state;
+  }
+  const HitZone hit = hitTest(event.x, event.y);
+  const TouchZone zone = state == SETTINGS ? SETTINGS_ZONE : touchZone(hit);
+  if (event.time - zoneLastPress[zone] < zoneDebounceMicros[zone]) {
+    return state; // bounce
+  }
+  zoneLastPress[zone] = event.time;
+
+  //    Serial.println(F("Touch"));
+  States from = state;
+  if (state == END_GAME && clockEngine.isFlagFallenAfter(event.time)) {
+    // pressed before the flag fell, the reading completed after it: the press
+    // acts on the game it was made in and the engine takes the fall back
+    from = flagFellState;
+  }
+  const UiActionHandler handler = (UiActionHandler) pgm_read_ptr(&uiActions[pgm_read_byte(&uiTransitions[isWhiteDown][from][hit])]);
+  if (handler) {
+    setScreenRotation(INITIAL_ROTATION);
+    state = from;
+    handler(event);
+  }
+  return state;
+}
+
+void resetAction(const TouchEvent& event) {
+  resetGame();
+}
+
+void settingsAction(const TouchEvent& event) {
+  showSettings();
+}
+
+void selectGameAction(const TouchEvent& event) {
+  const int i = touchBand(event.x, touchLayout.columns, settingsCols - 1);
+  const int j = touchBand(-event.y, touchLayout.rows, settingsRows - 1);
+  const int newSelectedGameIndex = settingsCellGame(i, j);
+  if (newSelectedGameIndex < 0) {
+    if (settingsPages > 1 && j * settingsCols + i == gamesPerPage) {
+      flipSettingsPage();
     }
+  } else if (newSelectedGameIndex == selectedGameIndex) {
+    resetGame();
+  } else {
+    changeSettingsSelectionTo(newSelectedGameIndex);
+  }
+}
+
+void startWhiteUpAction(const TouchEvent& event) {
+  startGame(event, false);
+}
 
+void startWhiteDownAction(const TouchEvent& event) {
+  startGame(event, true);
+}
+
+// the actions below paint over the screen, behind the units still queued for it
+void startGame(const TouchEvent& event, bool whiteDown) {
+  renderQueue.runOrPush(printClockMode, BLACK);
+  state = WHITE_PLAYING;
+  // assign white color
+  isWhiteDown = whiteDown;
+  whitesRotation = whiteDown ? 2 : 0;
+  blacksRotation = whiteDown ? 0 : 2;
+  renderQueue.runOrPush(paintPawnsIcons, 0);
+  clockEngine.start(ClockEngine::WHITES, event.time);
+  renderQueue.runOrPush(paintClocks, 0);
+  queueIcons(foregroundColor, backgroundColor);
+}
+
+void pauseAction(const TouchEvent& event) {
+  state = state == WHITE_PLAYING ? WHITE_IN_PAUSE : BLACK_IN_PAUSE;
+  clockEngine.pause(event.time);
+  renderQueue.runOrPush(paintPauseTimes, 0);
+  queueIcons(alertColor, alertColor);
+}
+
+void resumeAction(const TouchEvent& event) {
+  state = state == WHITE_IN_PAUSE ? WHITE_PLAYING : BLACK_PLAYING;
+  clockEngine.resume(event.time);
+  // the clock may stay frozen in the delay, do not leave it in pause colors
+  renderQueue.runOrPush(paintClocks, 0);
+  queueIcons(foregroundColor, backgroundColor);
+}
+
+void flipAction(const TouchEvent& event) {
+  const States mover = state;
+  clockEngine.switchTurn(event.time);
+  if (state == mover) {  // the flag may have fallen before the press
+    state = mover == WHITE_PLAYING ? BLACK_PLAYING : WHITE_PLAYING;
+    renderQueue.runOrPush(paintClocks, 0);
   }
-  return state;
 }
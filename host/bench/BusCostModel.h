@@ -0,0 +1,51 @@
+/*!
+   @file BusCostModel.h
+
+   This is part of the TFT Virtual Segment Display for Arduino
+   Cycle cost model of an ILI9341 on the 8-bit parallel shield driven by an
+   ATmega328P at 16 MHz, applied to the work counted by the host stand-in.
+   Coarse by design, it is meant to rank changes, not to predict to the cycle.
+
+
+   Written by Enrique Albertos, with
+   contributions from the open source community.
+
+   Public Domain
+
+*/
+
+#ifndef _BusCostModel_H_
+#define _BusCostModel_H_
+
+#include "Adafruit_TFTLCD.h"
+
+#define CPU_MHZ 16
+
+// write8 on the UNO shield: data split over PORTB and PORTD plus the WR strobe
+static const uint32_t CYCLES_PER_BUS_WRITE = 10;
+// flood of a color whose two bytes match: the data stays on the port, WR low and high
+static const uint32_t CYCLES_PER_STROBE = 4;
+// pushColors loading a pixel from its RAM buffer and counting it down
+static const uint32_t CYCLES_PER_RAM_PIXEL = 6;
+// CS and CD toggling, register packing and argument shuffling around a window setup
+static const uint32_t CYCLES_PER_ADDRESS_WINDOW = 40;
+// virtual call, clipping and bookkeeping of one driver primitive
+static const uint32_t CYCLES_PER_PRIMITIVE = 60;
+// opening and closing a bus transaction
+static const uint32_t CYCLES_PER_TRANSACTION = 20;
+
+/*!
+   @brief    Estimate the cpu cycles spent on the counted display work
+   @param stats   counters of the host stand-in
+   @returns the estimated cycles
+*/
+inline uint64_t estimateCycles(const TFTLCDStats& stats) {
+  return (uint64_t)(stats.busWrites - stats.strobes) * CYCLES_PER_BUS_WRITE
+         + (uint64_t)stats.strobes * CYCLES_PER_STROBE
+         + (uint64_t)stats.ramPixels * CYCLES_PER_RAM_PIXEL
+         + (uint64_t)stats.addressWindows * CYCLES_PER_ADDRESS_WINDOW
+         + (uint64_t)stats.primitives * CYCLES_PER_PRIMITIVE
+         + (uint64_t)stats.transactions * CYCLES_PER_TRANSACTION;
+}
+
+#endif // _BusCostModel_H_
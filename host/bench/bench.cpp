@@ -0,0 +1,274 @@
+/*!
+   @file bench.cpp
+
+   This is part of the TFT Virtual Segment Display for Arduino
+   Rendering micro-benchmarks run against the host display stand-in.
+
+   - module_*: all 100 digit to digit transitions of one seven segment module
+   - clock_*: displayMillis for every second of a countdown, one tick per second
+   - icon_*: one icon as drawBitmap draws it, as a transparent run length
+     encoded icon and as an opaque one
+   - label_*: one status label as tft.print draws it and as a TFTSpanLabel
+
+   Module and clock geometries are the ones used by the sketch. Results are
+   written as CSV. With --check the per call cost of every case is compared
+   with a baseline CSV and the run fails when one got worse.
+
+   usage: bench [--check baseline.csv]
+
+
+   Written by Enrique Albertos, with
+   contributions from the open source community.
+
+   Public Domain
+
+*/
+
+#include "Arduino.h"
+#include "Adafruit_TFTLCD.h"
+#include "TFTSevenSegmentModule.h"
+#include "TFTSevenSegmentClockDisplay.h"
+#include "TFTIconBlitter.h"
+#include "TFTSpanLabel.h"
+#include "ChessClockIcons.h"
+#include "../icons/bitmaps.h"
+#include "BusCostModel.h"
+
+#define MAX_CASES 64
+#define TOLERANCE_PERCENT 0.5
+
+#define BLACK 0x0000
+#define WHITE 0xFFFF
+
+static Adafruit_TFTLCD tft;
+
+struct BenchResult {
+  char name[32];
+  int16_t ledWidth;
+  uint32_t calls;
+  TFTLCDStats total;
+  uint64_t cycles;
+  uint64_t worstCycles;  // most expensive single call
+};
+
+static BenchResult s_results[MAX_CASES];
+static uint8_t s_resultCount = 0;
+
+static void accumulate(TFTLCDStats& total, const TFTLCDStats& stats) {
+  total.primitives += stats.primitives;
+  total.addressWindows += stats.addressWindows;
+  total.pixels += stats.pixels;
+  total.transactions += stats.transactions;
+  total.busWrites += stats.busWrites;
+  total.rotations += stats.rotations;
+}
+
+static BenchResult& newResult(const char *name, int16_t ledWidth) {
+  if (s_resultCount == MAX_CASES) {
+    // the cases hold references into s_results, it cannot grow
+    fprintf(stderr, "too many cases at %s, raise MAX_CASES\n", name);
+    exit(2);
+  }
+  BenchResult& result = s_results[s_resultCount++];
+  memset(&result, 0, sizeof(result));
+  snprintf(result.name, sizeof(result.name), "%s", name);
+  result.ledWidth = ledWidth;
+  return result;
+}
+
+/*!
+   @brief    Account the work counted since the last reset as one call
+   @param result   case being measured
+*/
+static void measured(BenchResult& result) {
+  const uint64_t cycles = estimateCycles(tft.hostStats());
+  accumulate(result.total, tft.hostStats());
+  result.cycles += cycles;
+  if (cycles > result.worstCycles) {
+    result.worstCycles = cycles;
+  }
+  result.calls++;
+  tft.hostResetStats();
+}
+
+/*!
+   @brief    All 100 digit to digit transitions of one module
+*/
+static void benchModule(const char *name, int16_t w, int16_t h, int16_t ledWidth) {
+  BenchResult& result = newResult(name, ledWidth);
+  TFTSevenSegmentModule module(&tft, 20, 20, w, h, WHITE, BLACK, ledWidth, true);
+  for (int16_t from = 0; from < 10; from++) {
+    for (int16_t to = 0; to < 10; to++) {
+      module.display(from);
+      tft.hostResetStats();
+      module.display(to);
+      measured(result);
+    }
+  }
+}
+
+/*!
+   @brief    Count down a clock one second per tick, as the sketch does while playing
+*/
+static void benchClock(const char *name, long seconds, int16_t w, int16_t h, int16_t ledWidth, boolean showHours) {
+  BenchResult& result = newResult(name, ledWidth);
+  TFTSevenSegmentClockDisplay clock(&tft, 10, 215, w, h, WHITE, BLACK, ledWidth, showHours, .75);
+  clock.displayMillis(seconds * 1000, true);
+  tft.hostResetStats();
+  for (long s = seconds - 1; s >= 0; s--) {
+    clock.displayMillis(s * 1000, true);
+    measured(result);
+  }
+}
+
+/*!
+   @brief    Count down the low time one tenth per tick, as the sketch does below
+             the low time threshold
+*/
+static void benchTenths(const char *name, long seconds, int16_t w, int16_t h, int16_t ledWidth, boolean showHours) {
+  BenchResult& result = newResult(name, ledWidth);
+  TFTSevenSegmentClockDisplay clock(&tft, 10, 215, w, h, WHITE, BLACK, ledWidth, showHours, .75);
+  clock.displayTenths(seconds * 1000);
+  tft.hostResetStats();
+  for (long t = seconds * 10 - 1; t >= 0; t--) {
+    clock.displayTenths(t * 100);
+    measured(result);
+  }
+}
+
+/*!
+   @brief    Draw one icon the three ways, the bitmap and the encoded icon must
+             be the same picture
+*/
+static void benchIcon(const char *name, const uint8_t* bitmap, const uint8_t* icon) {
+  char caseName[32];
+  const uint8_t w = TFTIconBlitter::width(icon);
+  const uint8_t h = TFTIconBlitter::height(icon);
+  tft.hostResetStats();
+
+  snprintf(caseName, sizeof(caseName), "icon_bitmap_%s", name);
+  BenchResult& bitmapResult = newResult(caseName, 0);
+  tft.drawBitmap(20, 20, bitmap, w, h, WHITE);
+  measured(bitmapResult);
+
+  snprintf(caseName, sizeof(caseName), "icon_rle_%s", name);
+  BenchResult& rleResult = newResult(caseName, 0);
+  TFTIconBlitter::draw(&tft, 20, 20, icon, WHITE);
+  measured(rleResult);
+
+  snprintf(caseName, sizeof(caseName), "icon_opaque_%s", name);
+  BenchResult& opaqueResult = newResult(caseName, 0);
+  TFTIconBlitter::drawOpaque(&tft, 20, 20, icon, WHITE, BLACK);
+  measured(opaqueResult);
+}
+
+/*!
+   @brief    Draw one label through the GFX font and from the compiled glyphs
+*/
+static void benchLabel(const char *name, const __FlashStringHelper* text) {
+  char caseName[32];
+  TFTSpanLabel label;
+  label.append(text);
+  tft.hostResetStats();
+
+  snprintf(caseName, sizeof(caseName), "label_print_%s", name);
+  BenchResult& printResult = newResult(caseName, 0);
+  tft.setTextColor(WHITE);
+  tft.setCursor(20, 20);
+  tft.print(text);
+  measured(printResult);
+
+  snprintf(caseName, sizeof(caseName), "label_span_%s", name);
+  BenchResult& spanResult = newResult(caseName, 0);
+  label.draw(&tft, 20, 20, WHITE);
+  measured(spanResult);
+}
+
+static void printResults(FILE *out) {
+  fprintf(out, "case,led_width,calls,pixels,address_windows,primitives,transactions,bus_writes,"
+          "cycles_per_call,us_per_call,worst_us\n");
+  for (uint8_t i = 0; i < s_resultCount; i++) {
+    const BenchResult& r = s_results[i];
+    fprintf(out, "%s,%d,%lu,%lu,%lu,%lu,%lu,%lu,%.1f,%.2f,%.2f\n", r.name, r.ledWidth,
+            (unsigned long)r.calls, (unsigned long)r.total.pixels, (unsigned long)r.total.addressWindows,
+            (unsigned long)r.total.primitives, (unsigned long)r.total.transactions,
+            (unsigned long)r.total.busWrites, (double)r.cycles / r.calls,
+            (double)r.cycles / r.calls / CPU_MHZ, (double)r.worstCycles / CPU_MHZ);
+  }
+}
+
+/*!
+   @brief    Compare the per call cost with a baseline CSV
+   @param path   baseline written by an earlier run
+   @returns number of cases that got worse
+*/
+static int checkBaseline(const char *path) {
+  FILE *in = fopen(path, "r");
+  if (!in) {
+    fprintf(stderr, "cannot read baseline %s\n", path);
+    return 1;
+  }
+  char line[256];
+  int regressions = 0;
+  fgets(line, sizeof(line), in);  // header
+  while (fgets(line, sizeof(line), in)) {
+    char name[32];
+    double baselineCycles;
+    if (sscanf(line, "%31[^,],%*[^,],%*[^,],%*[^,],%*[^,],%*[^,],%*[^,],%*[^,],%lf", name, &baselineCycles) != 2) {
+      continue;
+    }
+    for (uint8_t i = 0; i < s_resultCount; i++) {
+      const BenchResult& r = s_results[i];
+      if (strcmp(r.name, name) != 0) {
+        continue;
+      }
+      const double cycles = (double)r.cycles / r.calls;
+      if (cycles > baselineCycles * (1 + TOLERANCE_PERCENT / 100)) {
+        fprintf(stderr, "REGRESSION %s: %.1f cycles per call, baseline %.1f\n", name, cycles, baselineCycles);
+        regressions++;
+      } else if (cycles < baselineCycles * (1 - TOLERANCE_PERCENT / 100)) {
+        fprintf(stderr, "improved %s: %.1f cycles per call, baseline %.1f\n", name, cycles, baselineCycles);
+      }
+    }
+  }
+  fclose(in);
+  return regressions;
+}
+
+int main(int argc, char **argv) {
+  tft.begin(tft.readID());
+
+  // minutes layout: 35x70 led 8, seconds 26x52 led 7
+  benchModule("module_35x70", 35, 70, 8);
+  benchModule("module_26x52", 26, 52, 7);
+  // hours layout: 26x60 led 6, seconds 19x45 led 5
+  benchModule("module_26x60", 26, 60, 6);
+  benchModule("module_19x45", 19, 45, 5);
+  // moves counter
+  benchModule("module_5x8", 5, 8, 1);
+
+  benchClock("clock_minutes_1h", 3600, 35, 70, 8, false);
+  benchClock("clock_hours_1h", 3600, 26, 60, 6, true);
+  benchClock("clock_hours_2h", 7200, 26, 60, 6, true);
+  benchTenths("clock_minutes_tenths", 20, 35, 70, 8, false);
+  benchTenths("clock_hours_tenths", 20, 26, 60, 6, true);
+
+  benchIcon("pause", epd_bitmap_pause, rle_icon_pause);
+  benchIcon("reset", epd_bitmap_reset, rle_icon_reset);
+  benchIcon("settings", epd_bitmap_settings, rle_icon_settings);
+  benchIcon("pawn", epd_bitmap_pawn, rle_icon_pawn);
+
+  benchLabel("mode", F("BRONSTEIN"));
+  benchLabel("stage", F("120m/40mv"));
+
+  printResults(stdout);
+
+  if (argc > 2 && strcmp(argv[1], "--check") == 0) {
+    const int regressions = checkBaseline(argv[2]);
+    if (regressions) {
+      fprintf(stderr, "%d case(s) slower than %s\n", regressions, argv[2]);
+      return 1;
+    }
+  }
+  return 0;
+}
@@ -0,0 +1,153 @@
+/*!
+   @file chessclock_host.cpp
+
+   This is part of the TFT Virtual Segment Display for Arduino
+   Runs the chess clock sketch on Linux against the host stand-ins. Plays a
+   short scripted game on virtual time and prints the display work of each
+   phase, optionally saving a PPM frame after each one.
+
+   usage: chessclock_host [frames directory]
+
+
+   Written by Enrique Albertos, with
+   contributions from the open source community.
+
+   Public Domain
+
+*/
+
+#include "Arduino.h"
+#include "chessclock.ino"
+
+static const char *s_framesDir = nullptr;
+
+/*!
+   @brief    Run the sketch loop, the sketch sleeps on the simulated timer
+             between its deadlines
+   @param ms   virtual milliseconds to run
+*/
+static void run(unsigned long ms) {
+  const uint64_t end = micros() + ms * 1000ULL;
+  hostTimerSetHorizon(end);
+  while (micros() < end) {
+    loop();
+  }
+}
+
+/*!
+   @brief    Touch the panel at a screen point of the initial rotation, the
+             raw readings are the inverse of the sketch calibration
+   @param x   screen x
+   @param y   screen y
+*/
+static void tap(int16_t x, int16_t y) {
+  TouchScreen::hostPress(TS_RT + (long)x * (TS_LEFT - TS_RT) / TFTWIDTH,
+                         TS_BOT + (long)y * (TS_TOP - TS_BOT) / TFTHEIGHT,
+                         (MINPRESSURE + MAXPRESSURE) / 2);
+  run(50);
+  TouchScreen::hostRelease();
+  run(450);
+}
+
+/*!
+   @brief    Print the work counted since the previous phase and save a frame
+   @param name   phase name
+*/
+static void phase(const char *name) {
+  const TFTLCDStats& stats = tft.hostStats();
+  printf("%-16s %10lu %10lu %10lu %10lu %10lu %10lu\n", name,
+         (unsigned long)stats.primitives, (unsigned long)stats.addressWindows,
+         (unsigned long)stats.pixels, (unsigned long)stats.transactions,
+         (unsigned long)stats.busWrites, (unsigned long)stats.rotations);
+  if (s_framesDir) {
+    char path[256];
+    snprintf(path, sizeof(path), "%s/%s.ppm", s_framesDir, name);
+    if (!tft.hostWritePPM(path)) {
+      fprintf(stderr, "cannot write %s\n", path);
+    }
+  }
+  tft.hostResetStats();
+}
+
+int main(int argc, char **argv) {
+  if (argc > 1) {
+    s_framesDir = argv[1];
+  }
+  printf("%-16s %10s %10s %10s %10s %10s %10s\n", "phase",
+         "primitives", "windows", "pixels", "transact", "busWrites", "rotations");
+
+  TouchScreen::hostConnect(XP, YP, XM, YM, 300);
+  setup();
+  renderQueue.setBudget(0); // one unit per loop iteration, as if drawing took the whole budget
+  run(1000);               // touches are ignored during the first debounce period
+  phase("reset");
+
+  tap(120, 300);           // white takes the lower field, white clock starts
+  phase("start");
+
+  run(10000);
+  phase("white_10s");
+
+  tap(120, 60);            // white moves
+  phase("white_moves");
+
+  run(10000);
+  phase("black_10s");
+
+  tap(120, 300);           // black moves
+  phase("black_moves");
+
+  tap(120, 160);           // pause
+  phase("pause");
+
+  tap(120, 160);           // resume
+  run(5000);
+  phase("resume_5s");
+
+  tap(20, 160);            // settings page
+  phase("settings");
+
+  tap(20, 160);            // the clock was paused, now the settings page
+  tap(210, 300);           // next page of presets
+  phase("settings_page");
+
+  tap(210, 300);           // back to the first page
+  tap(210, 240);           // select 20, US delay 5 min + 3 s
+  tap(210, 240);           // load it
+  phase("delay_select");
+
+  tap(120, 300);           // white starts in the delay period
+  phase("delay_start");
+
+  run(3000);               // countdown to the end of the delay, then the clock runs
+  phase("delay_3s");
+
+  tap(120, 60);            // white moves, black delay starts
+  phase("delay_moves");
+
+  const TickStats& ticks = tickScheduler.stats();
+  printf("ticks %lu, missed %lu, late max %lu us, mean %.1f us\n",
+         (unsigned long)ticks.ticks, (unsigned long)ticks.missed, (unsigned long)ticks.maxLateMicros,
+         ticks.ticks ? (double)ticks.totalLateMicros / ticks.ticks : 0.0);
+  printf("boundary to first pixel %lu, max %lu us, buckets of %d us:", (unsigned long)boundaryLatency.count(),
+         (unsigned long)boundaryLatency.maxMicros(), 1 << LATENCY_BUCKET_SHIFT);
+  for (uint8_t i = 0; i < LATENCY_BUCKETS; i++) {
+    printf(" %u", boundaryLatency.bucket(i));
+  }
+  printf("\n");
+  const RenderStats& render = renderQueue.stats();
+  printf("render units %lu, frames %lu, overruns %lu, max frame %lu us\n", (unsigned long)render.units,
+         (unsigned long)render.frames, (unsigned long)render.overruns, (unsigned long)render.maxFrameMicros);
+  printf("progmem copies %lu bytes\n", (unsigned long)hostProgmemCopied());
+  printf("stray LCD writes %lu\n", (unsigned long)tft.hostStrayWrites());
+#if defined(CHESSCLOCK_PROFILE)
+  Serial.hostOutput(stdout); // the profile as the sketch prints it, virtual time does not advance while drawing
+  Serial.hostInput("p");
+  run(TOUCH_SAMPLE_MILLIS);
+#endif
+  if (tft.hostStrayWrites() > 0) {
+    fprintf(stderr, "LCD writes while the touch panel held its pins\n");
+    return 1;
+  }
+  return 0;
+}
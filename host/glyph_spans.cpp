@@ -0,0 +1,115 @@
+/*!
+   @file glyph_spans.cpp
+
+   This is part of the Arduino UNO TFT Chess Clock
+   Compiles glyphs of the classic 5x7 GFX font into the vertical runs drawn by
+   TFTSpanLabel. Each glyph is a list of bytes, the start row in the high
+   nibble and the run length in the low one; a 0 byte moves to the next
+   column. The header is written to the standard output.
+
+   usage: glyph_spans characters
+
+
+   Written by Enrique Albertos, with
+   contributions from the open source community.
+
+   Public Domain
+
+*/
+
+#include <stdio.h>
+#include <string.h>
+#include <algorithm>
+#include <string>
+#include <vector>
+#include "Arduino.h"
+
+#define FONT_COLUMNS 5
+#define FONT_ROWS 8
+
+extern const unsigned char font[];
+
+/*!
+   @brief    Vertical runs of one glyph, column by column
+   @param c   character
+   @returns the run bytes
+*/
+static std::vector<unsigned> compile(unsigned char c) {
+  std::vector<unsigned> runs;
+  unsigned pendingColumns = 0;
+  for (int i = 0; i < FONT_COLUMNS; i++) {
+    const unsigned line = font[c * FONT_COLUMNS + i];
+    for (int j = 0; j < FONT_ROWS; j++) {
+      if (!(line & (1 << j))) {
+        continue;
+      }
+      int length = 1;
+      while (j + length < FONT_ROWS && (line & (1 << (j + length)))) {
+        ++length;
+      }
+      for (; pendingColumns > 0; pendingColumns--) {
+        runs.push_back(0);
+      }
+      runs.push_back(j << 4 | length);
+      j += length;
+    }
+    ++pendingColumns;
+  }
+  return runs;
+}
+
+int main(int argc, char **argv) {
+  if (argc != 2) {
+    fprintf(stderr, "usage: glyph_spans characters\n");
+    return 1;
+  }
+  std::string chars(argv[1]);
+  std::sort(chars.begin(), chars.end());
+  chars.erase(std::unique(chars.begin(), chars.end()), chars.end());
+
+  printf("/*!\n"
+         "   @file StatusGlyphs.h\n\n"
+         "   This is part of the Arduino UNO TFT Chess Clock\n"
+         "   Glyphs of the status labels compiled into vertical runs for TFTSpanLabel,\n"
+         "   generated by host/glyph_spans, do not edit\n\n\n"
+         "   Written by Enrique Albertos, with\n"
+         "   contributions from the open source community.\n\n"
+         "   Public Domain\n\n"
+         "*/\n\n"
+         "#ifndef _StatusGlyphs_H_\n"
+         "#define _StatusGlyphs_H_\n\n"
+         "#include \"arduino.h\"\n\n"
+         "#define STATUS_GLYPHS %u\n\n", (unsigned)chars.size());
+
+  printf("// compiled characters, sorted\n");
+  printf("const char statusGlyphChars[STATUS_GLYPHS + 1] PROGMEM = \"%s\";\n\n", chars.c_str());
+
+  std::vector<unsigned> offsets;
+  std::vector<unsigned> runs;
+  for (size_t i = 0; i < chars.size(); i++) {
+    offsets.push_back(runs.size());
+    const std::vector<unsigned> glyph = compile(chars[i]);
+    runs.insert(runs.end(), glyph.begin(), glyph.end());
+  }
+  offsets.push_back(runs.size());
+
+  printf("// first run of each glyph, the last entry ends the last glyph\n");
+  printf("const uint16_t statusGlyphOffsets[STATUS_GLYPHS + 1] PROGMEM = {");
+  for (size_t i = 0; i < offsets.size(); i++) {
+    printf("%s%u%s", i % 16 ? " " : "\n  ", offsets[i], i + 1 < offsets.size() ? "," : "\n");
+  }
+  printf("};\n\n");
+
+  printf("// start row << 4 | length, 0 moves to the next column\n");
+  printf("const uint8_t statusGlyphRuns[] PROGMEM = {");
+  for (size_t g = 0; g < chars.size(); g++) {
+    printf("\n  ");
+    for (unsigned i = offsets[g]; i < offsets[g + 1]; i++) {
+      printf("0x%02X, ", runs[i]);
+    }
+    printf("// '%c'", chars[g]);
+  }
+  printf("\n};\n\n");
+  printf("#endif // _StatusGlyphs_H_\n");
+  return 0;
+}
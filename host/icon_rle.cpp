@@ -0,0 +1,180 @@
+/*!
+   @file icon_rle.cpp
+
+   This is part of the TFT Virtual Segment Display for Arduino
+   Converts the 1 bit PROGMEM bitmaps exported by image2cpp into the run length
+   encoded icons drawn by TFTIconBlitter. Every array of the input must follow
+   a "// 'name', WxHpx" comment, rows are padded to whole bytes, MSB first.
+   An array epd_bitmap_NAME becomes rle_icon_NAME. The header is written to
+   the standard output.
+
+   usage: icon_rle bitmaps.h
+
+
+   Written by Enrique Albertos, with
+   contributions from the open source community.
+
+   Public Domain
+
+*/
+
+#include <ctype.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <vector>
+
+#define BITMAP_PREFIX "epd_bitmap_"
+#define MAX_RUN 255
+
+/*!
+   @brief    Read a whole file
+   @param path   file to read
+   @param text   set to its content
+   @returns false if it cannot be read
+*/
+static bool readFile(const char *path, std::string& text) {
+  FILE *in = fopen(path, "rb");
+  if (!in) {
+    return false;
+  }
+  char buffer[4096];
+  size_t n;
+  while ((n = fread(buffer, 1, sizeof(buffer), in)) > 0) {
+    text.append(buffer, n);
+  }
+  fclose(in);
+  return true;
+}
+
+/*!
+   @brief    Append a run, splitting it with empty runs of the other kind when it
+             does not fit in a byte
+   @param runs     encoded runs
+   @param length   run length in pixels
+*/
+static void appendRun(std::vector<unsigned>& runs, unsigned length) {
+  while (length > MAX_RUN) {
+    runs.push_back(MAX_RUN);
+    runs.push_back(0);
+    length -= MAX_RUN;
+  }
+  runs.push_back(length);
+}
+
+/*!
+   @brief    Encode a bitmap in raster order, clear run first
+   @param bits     bitmap bytes
+   @param w        width in pixels
+   @param h        height in pixels
+   @returns the run lengths
+*/
+static std::vector<unsigned> encode(const std::vector<unsigned>& bits, int w, int h) {
+  const int byteWidth = (w + 7) / 8;
+  std::vector<unsigned> runs;
+  bool set = false;
+  unsigned length = 0;
+  for (int j = 0; j < h; j++) {
+    for (int i = 0; i < w; i++) {
+      const bool pixel = bits[j * byteWidth + i / 8] & (0x80 >> (i & 7));
+      if (pixel != set) {
+        appendRun(runs, length);
+        set = pixel;
+        length = 0;
+      }
+      ++length;
+    }
+  }
+  appendRun(runs, length);
+  return runs;
+}
+
+/*!
+   @brief    Print one icon as a PROGMEM array
+   @param name   icon name
+   @param w      width in pixels
+   @param h      height in pixels
+   @param runs   run lengths
+*/
+static void printIcon(const std::string& name, int w, int h, const std::vector<unsigned>& runs) {
+  printf("// '%s', %dx%dpx, %u runs\n", name.c_str(), w, h, (unsigned)runs.size());
+  printf("const uint8_t rle_icon_%s[] PROGMEM = {\n  %d, %d,", name.c_str(), w, h);
+  for (size_t i = 0; i < runs.size(); i++) {
+    printf("%s%u%s", i % 16 ? " " : "\n  ", runs[i], i + 1 < runs.size() ? "," : "\n");
+  }
+  printf("};\n\n");
+}
+
+int main(int argc, char **argv) {
+  std::string text;
+  if (argc != 2 || !readFile(argv[1], text)) {
+    fprintf(stderr, "usage: icon_rle bitmaps.h\n");
+    return 1;
+  }
+
+  printf("/*!\n"
+         "   @file ChessClockIcons.h\n\n"
+         "   This is part of the Arduino UNO TFT Chess Clock\n"
+         "   Run length encoded icons for TFTIconBlitter, generated by host/icon_rle\n"
+         "   from host/icons/bitmaps.h, do not edit\n\n\n"
+         "   Written by Enrique Albertos, with\n"
+         "   contributions from the open source community.\n\n"
+         "   Public Domain\n\n"
+         "*/\n\n"
+         "#ifndef _ChessClockIcons_H_\n"
+         "#define _ChessClockIcons_H_\n\n"
+         "#include \"arduino.h\"\n\n");
+
+  int icons = 0;
+  size_t at = 0;
+  while ((at = text.find("// '", at)) != std::string::npos) {
+    int w = 0;
+    int h = 0;
+    const size_t comma = text.find("',", at);
+    if (comma == std::string::npos || sscanf(text.c_str() + comma + 2, " %dx%dpx", &w, &h) != 2 || w <= 0 || h <= 0) {
+      at += 4;
+      continue;
+    }
+    const size_t prefix = text.find(BITMAP_PREFIX, comma);
+    const size_t open = text.find('{', comma);
+    const size_t close = text.find('}', open);
+    if (prefix == std::string::npos || open == std::string::npos || close == std::string::npos || prefix > open) {
+      fprintf(stderr, "icon_rle: no array after the comment at offset %u\n", (unsigned)at);
+      return 1;
+    }
+    std::string name;
+    for (size_t i = prefix + strlen(BITMAP_PREFIX); isalnum(text[i]) || text[i] == '_'; i++) {
+      name += text[i];
+    }
+
+    std::vector<unsigned> bits;
+    const char *p = text.c_str() + open + 1;
+    const char *end = text.c_str() + close;
+    while (p < end) {
+      char *next;
+      const unsigned long value = strtoul(p, &next, 0);
+      if (next == p) {
+        ++p;
+        continue;
+      }
+      bits.push_back(value & 0xFF);
+      p = next;
+    }
+    if ((int)bits.size() != (w + 7) / 8 * h) {
+      fprintf(stderr, "icon_rle: %s has %u bytes, %dx%d needs %d\n", name.c_str(), (unsigned)bits.size(), w, h,
+              (w + 7) / 8 * h);
+      return 1;
+    }
+    if (w > 255 || h > 255) {
+      fprintf(stderr, "icon_rle: %s is larger than 255 pixels\n", name.c_str());
+      return 1;
+    }
+    printIcon(name, w, h, encode(bits, w, h));
+    ++icons;
+    at = close;
+  }
+
+  printf("#endif // _ChessClockIcons_H_\n");
+  return icons > 0 ? 0 : 1;
+}
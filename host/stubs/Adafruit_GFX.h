@@ -0,0 +1,85 @@
+/*!
+   @file Adafruit_GFX.h
+
+   This is part of the TFT Virtual Segment Display for Arduino
+   Host stand-in for the Adafruit_GFX core graphics library. Same public
+   methods as the parts of the library used by the chess clock, drawing ends
+   up in the drawPixel and fast line primitives of the display class.
+
+
+   Written by Enrique Albertos, with
+   contributions from the open source community.
+
+   Public Domain
+
+*/
+
+#ifndef _HostAdafruit_GFX_H_
+#define _HostAdafruit_GFX_H_
+
+#include "Arduino.h"
+
+class Adafruit_GFX : public Print {
+  public:
+    Adafruit_GFX(int16_t w, int16_t h);
+    virtual ~Adafruit_GFX() {}
+
+    virtual void drawPixel(int16_t x, int16_t y, uint16_t color) = 0;
+
+    virtual void startWrite();
+    virtual void writePixel(int16_t x, int16_t y, uint16_t color);
+    virtual void writeFillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color);
+    virtual void writeFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color);
+    virtual void writeFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color);
+    virtual void endWrite();
+
+    virtual void setRotation(uint8_t r);
+    virtual void drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color);
+    virtual void drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color);
+    virtual void fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color);
+    virtual void fillScreen(uint16_t color);
+
+    void drawRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color);
+    void drawBitmap(int16_t x, int16_t y, const uint8_t bitmap[], int16_t w, int16_t h, uint16_t color);
+    void drawChar(int16_t x, int16_t y, unsigned char c, uint16_t color, uint16_t bg, uint8_t size);
+
+    void setCursor(int16_t x, int16_t y);
+    void setTextColor(uint16_t c);
+    void setTextColor(uint16_t c, uint16_t bg);
+    void setTextSize(uint8_t s);
+    void setTextWrap(boolean w);
+
+    size_t write(uint8_t) override;
+    using Print::write;
+
+    int16_t width(void) const {
+      return _width;
+    }
+    int16_t height(void) const {
+      return _height;
+    }
+    uint8_t getRotation(void) const {
+      return rotation;
+    }
+    int16_t getCursorX(void) const {
+      return cursor_x;
+    }
+    int16_t getCursorY(void) const {
+      return cursor_y;
+    }
+
+  protected:
+    const int16_t WIDTH;   // display width as modified by current rotation
+    const int16_t HEIGHT;  // display height as modified by current rotation
+    int16_t _width;
+    int16_t _height;
+    int16_t cursor_x{};
+    int16_t cursor_y{};
+    uint16_t textcolor{0xFFFF};
+    uint16_t textbgcolor{0xFFFF};
+    uint8_t textsize{1};
+    uint8_t rotation{};
+    boolean wrap{true};
+};
+
+#endif // _HostAdafruit_GFX_H_
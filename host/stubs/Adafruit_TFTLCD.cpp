@@ -0,0 +1,316 @@
+/*!
+   @file Adafruit_TFTLCD.cpp
+
+   This is part of the TFT Virtual Segment Display for Arduino
+   Host stand-in for the Adafruit_TFTLCD 8-bit parallel ILI9341 driver.
+   Bus writes follow the ILI9341 code paths of the real driver: a window
+   setup is two 32 bit register writes, every pixel is two 8 bit strobes and
+   the fill primitives reset the lower-right window corner afterwards.
+
+
+   Written by Enrique Albertos, with
+   contributions from the open source community.
+
+   Public Domain
+
+*/
+
+#include "Adafruit_TFTLCD.h"
+
+static const uint32_t WINDOW_WRITES = 10;    // two commands with four data bytes each
+static const uint32_t MEMORY_WRITE = 1;      // memory write command
+static const uint32_t PIXEL_WRITES = 2;      // high and low byte
+static const uint32_t SET_LR_WRITES = 8;     // two register pairs
+static const uint32_t MADCTL_WRITES = 2;     // command and data
+
+// the UNO shield carries D0 and D1 on pins 8 and 9, D2 to D7 on pins 2 to 7
+static const uint8_t DATA_PINS[] = { 8, 9, 2, 3, 4, 5, 6, 7 };
+
+Adafruit_TFTLCD::Adafruit_TFTLCD(uint8_t cs, uint8_t cd, uint8_t, uint8_t, uint8_t) : Adafruit_TFTLCD() {
+  // the driver takes the control lines and the data port as outputs
+  m_cs = cs;
+  m_cd = cd;
+  pinMode(cs, OUTPUT);
+  pinMode(cd, OUTPUT);
+  for (uint8_t pin : DATA_PINS) {
+    pinMode(pin, OUTPUT);
+  }
+}
+
+Adafruit_TFTLCD::Adafruit_TFTLCD(void) : Adafruit_GFX(TFTWIDTH, TFTHEIGHT) {
+  memset(m_framebuffer, 0, sizeof(m_framebuffer));
+}
+
+void Adafruit_TFTLCD::begin(uint16_t) {
+  setRotation(0);
+  m_windowX2 = _width - 1;
+  m_windowY2 = _height - 1;
+}
+
+void Adafruit_TFTLCD::reset(void) {}
+
+uint16_t Adafruit_TFTLCD::readID(void) {
+  return 0x9341;
+}
+
+void Adafruit_TFTLCD::drawPixel(int16_t x, int16_t y, uint16_t color) {
+  if ((x < 0) || (y < 0) || (x >= _width) || (y >= _height)) {
+    return;
+  }
+  startWrite();
+  m_stats.primitives++;
+  m_stats.addressWindows++;
+  m_stats.pixels++;
+  account(WINDOW_WRITES + MEMORY_WRITE + PIXEL_WRITES);
+  m_windowX1 = m_cursorX = x;
+  m_windowY1 = m_cursorY = y;
+  m_windowX2 = _width - 1;
+  m_windowY2 = _height - 1;
+  writePixelData(color);
+  endWrite();
+}
+
+void Adafruit_TFTLCD::drawFastHLine(int16_t x, int16_t y, int16_t length, uint16_t color) {
+  int16_t x2;
+  if ((length <= 0) || (y < 0) || (y >= _height) || (x >= _width) || ((x2 = (x + length - 1)) < 0)) {
+    return;
+  }
+  if (x < 0) {
+    length += x;
+    x = 0;
+  }
+  if (x2 >= _width) {
+    x2 = _width - 1;
+    length = x2 - x + 1;
+  }
+  startWrite();
+  m_stats.primitives++;
+  setAddrWindow(x, y, x2, y);
+  flood(color, length);
+  setLR();
+  endWrite();
+}
+
+void Adafruit_TFTLCD::drawFastVLine(int16_t x, int16_t y, int16_t length, uint16_t color) {
+  int16_t y2;
+  if ((length <= 0) || (x < 0) || (x >= _width) || (y >= _height) || ((y2 = (y + length - 1)) < 0)) {
+    return;
+  }
+  if (y < 0) {
+    length += y;
+    y = 0;
+  }
+  if (y2 >= _height) {
+    y2 = _height - 1;
+    length = y2 - y + 1;
+  }
+  startWrite();
+  m_stats.primitives++;
+  setAddrWindow(x, y, x, y2);
+  flood(color, length);
+  setLR();
+  endWrite();
+}
+
+void Adafruit_TFTLCD::fillRect(int16_t x1, int16_t y1, int16_t w, int16_t h, uint16_t fillcolor) {
+  int16_t x2, y2;
+  if ((w <= 0) || (h <= 0) || (x1 >= _width) || (y1 >= _height) ||
+      ((x2 = x1 + w - 1) < 0) || ((y2 = y1 + h - 1) < 0)) {
+    return;
+  }
+  if (x1 < 0) {
+    w += x1;
+    x1 = 0;
+  }
+  if (y1 < 0) {
+    h += y1;
+    y1 = 0;
+  }
+  if (x2 >= _width) {
+    x2 = _width - 1;
+    w = x2 - x1 + 1;
+  }
+  if (y2 >= _height) {
+    y2 = _height - 1;
+    h = y2 - y1 + 1;
+  }
+  startWrite();
+  m_stats.primitives++;
+  setAddrWindow(x1, y1, x2, y2);
+  flood(fillcolor, (uint32_t)w * (uint32_t)h);
+  setLR();
+  endWrite();
+}
+
+void Adafruit_TFTLCD::fillScreen(uint16_t color) {
+  startWrite();
+  m_stats.primitives++;
+  setAddrWindow(0, 0, _width - 1, _height - 1);
+  flood(color, (uint32_t)TFTWIDTH * (uint32_t)TFTHEIGHT);
+  endWrite();
+}
+
+void Adafruit_TFTLCD::setRotation(uint8_t x) {
+  Adafruit_GFX::setRotation(x);
+  startWrite();
+  m_stats.rotations++;
+  account(MADCTL_WRITES);
+  setAddrWindow(0, 0, _width - 1, _height - 1);
+  endWrite();
+}
+
+void Adafruit_TFTLCD::startWrite() {
+  if (m_writeDepth++ == 0) {
+    m_stats.transactions++;
+  }
+}
+
+void Adafruit_TFTLCD::endWrite() {
+  if (m_writeDepth > 0) {
+    m_writeDepth--;
+  }
+}
+
+void Adafruit_TFTLCD::setAddrWindow(int x1, int y1, int x2, int y2) {
+  m_stats.addressWindows++;
+  account(WINDOW_WRITES);
+  m_windowX1 = m_cursorX = x1;
+  m_windowY1 = m_cursorY = y1;
+  m_windowX2 = x2;
+  m_windowY2 = y2;
+}
+
+void Adafruit_TFTLCD::pushColors(uint16_t *data, uint8_t len, boolean first) {
+  m_stats.primitives++;
+  m_stats.pixels += len;
+  m_stats.ramPixels += len;
+  account((first ? MEMORY_WRITE : 0) + PIXEL_WRITES * len);
+  while (len--) {
+    writePixelData(*data++);
+  }
+}
+
+uint16_t Adafruit_TFTLCD::color565(uint8_t r, uint8_t g, uint8_t b) {
+  return ((r & 0xF8) << 8) | ((g & 0xFC) << 3) | (b >> 3);
+}
+
+const TFTLCDStats& Adafruit_TFTLCD::hostStats() const {
+  return m_stats;
+}
+
+uint32_t Adafruit_TFTLCD::hostStrayWrites() const {
+  return m_strayWrites;
+}
+
+void Adafruit_TFTLCD::hostResetStats() {
+  memset(&m_stats, 0, sizeof(m_stats));
+}
+
+uint16_t Adafruit_TFTLCD::hostPixel(int16_t x, int16_t y) const {
+  if ((x < 0) || (y < 0) || (x >= TFTWIDTH) || (y >= TFTHEIGHT)) {
+    return 0;
+  }
+  return m_framebuffer[y * TFTWIDTH + x];
+}
+
+boolean Adafruit_TFTLCD::hostWritePPM(const char *path) const {
+  FILE *out = fopen(path, "wb");
+  if (!out) {
+    return false;
+  }
+  fprintf(out, "P6\n%d %d\n255\n", TFTWIDTH, TFTHEIGHT);
+  for (uint32_t i = 0; i < (uint32_t)TFTWIDTH * TFTHEIGHT; i++) {
+    const uint16_t c = m_framebuffer[i];
+    const uint8_t rgb[3] = {
+      static_cast<uint8_t>(((c >> 11) & 0x1F) * 255 / 31),
+      static_cast<uint8_t>(((c >> 5) & 0x3F) * 255 / 63),
+      static_cast<uint8_t>((c & 0x1F) * 255 / 31)
+    };
+    fwrite(rgb, 1, sizeof(rgb), out);
+  }
+  return fclose(out) == 0;
+}
+
+void Adafruit_TFTLCD::flood(uint16_t color, uint32_t len) {
+  m_stats.pixels += len;
+  if (len > 1 && (color >> 8) == (color & 0xFF)) {
+    // both bytes match, after the first pixel the driver only strobes WR
+    m_stats.strobes += PIXEL_WRITES * (len - 1);
+  }
+  account(MEMORY_WRITE + PIXEL_WRITES * len);
+  while (len--) {
+    writePixelData(color);
+  }
+}
+
+void Adafruit_TFTLCD::setLR(void) {
+  m_stats.addressWindows++;
+  account(SET_LR_WRITES);
+}
+
+/*!
+   @brief    Store one pixel at the memory write cursor, the cursor walks the
+             address window row by row in rotated coordinates like the controller
+   @param color   565 color
+*/
+void Adafruit_TFTLCD::writePixelData(uint16_t color) {
+  int16_t x = m_cursorX;
+  int16_t y = m_cursorY;
+  if ((x >= 0) && (y >= 0) && (x < _width) && (y < _height)) {
+    int16_t t;
+    switch (rotation) {
+      case 1:
+        t = x;
+        x = WIDTH - 1 - y;
+        y = t;
+        break;
+      case 2:
+        x = WIDTH - 1 - x;
+        y = HEIGHT - 1 - y;
+        break;
+      case 3:
+        t = x;
+        x = y;
+        y = HEIGHT - 1 - t;
+        break;
+    }
+    m_framebuffer[y * TFTWIDTH + x] = color;
+  }
+  if (++m_cursorX > m_windowX2) {
+    m_cursorX = m_windowX1;
+    if (++m_cursorY > m_windowY2) {
+      m_cursorY = m_windowY1;
+    }
+  }
+}
+
+/*!
+   @brief    Whether the control lines and the data port are all outputs
+   @returns false while the touch panel still holds one of them
+*/
+boolean Adafruit_TFTLCD::hostBusDriven() const {
+  if (hostPinMode(m_cs) != OUTPUT || hostPinMode(m_cd) != OUTPUT) {
+    return false;
+  }
+  for (uint8_t pin : DATA_PINS) {
+    if (hostPinMode(pin) != OUTPUT) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/*!
+   @brief    Count bus writes, the drawing primitives open their own write so
+             only bare setAddrWindow and pushColors calls land here outside one
+   @param busWrites   8-bit writes of the call
+*/
+void Adafruit_TFTLCD::account(uint32_t busWrites) {
+  m_stats.busWrites += busWrites;
+  if (m_cs != 0xFF && !hostBusDriven()) {
+    m_strayWrites += busWrites;
+  }
+  if (m_writeDepth == 0) {
+    m_stats.transactions++;
+  }
+}
@@ -0,0 +1,110 @@
+/*!
+   @file Adafruit_TFTLCD.h
+
+   This is part of the TFT Virtual Segment Display for Arduino
+   Host stand-in for the Adafruit_TFTLCD 8-bit parallel ILI9341 driver.
+   Renders into an in-memory RGB565 framebuffer and counts the bus work the
+   real driver would do for each call.
+
+
+   Written by Enrique Albertos, with
+   contributions from the open source community.
+
+   Public Domain
+
+*/
+
+#ifndef _HostAdafruit_TFTLCD_H_
+#define _HostAdafruit_TFTLCD_H_
+
+#include "Adafruit_GFX.h"
+
+#define TFTWIDTH   240
+#define TFTHEIGHT  320
+
+/** Work counted by the stand-in since the last hostResetStats() */
+struct TFTLCDStats {
+  uint32_t primitives;      // drawing calls that reach the driver
+  uint32_t addressWindows;  // address window setups, lower-right resets included
+  uint32_t pixels;          // pixels pushed to the controller memory
+  uint32_t transactions;    // outermost startWrite, or driver calls made outside one
+  uint32_t busWrites;       // 8-bit writes strobed on the parallel bus
+  uint32_t strobes;         // of the bus writes, those that only toggle WR on the data left on the port
+  uint32_t ramPixels;       // pixels pushColors loads from a RAM buffer
+  uint32_t rotations;       // MADCTL changes
+};
+
+class Adafruit_TFTLCD : public Adafruit_GFX {
+  public:
+    Adafruit_TFTLCD(uint8_t cs, uint8_t cd, uint8_t wr, uint8_t rd, uint8_t rst);
+    Adafruit_TFTLCD(void);
+
+    void begin(uint16_t id = 0x9325);
+    void reset(void);
+    uint16_t readID(void);
+
+    void drawPixel(int16_t x, int16_t y, uint16_t color) override;
+    void drawFastHLine(int16_t x0, int16_t y0, int16_t w, uint16_t color) override;
+    void drawFastVLine(int16_t x0, int16_t y0, int16_t h, uint16_t color) override;
+    void fillRect(int16_t x, int16_t y1, int16_t w, int16_t h, uint16_t c) override;
+    void fillScreen(uint16_t color) override;
+    void setRotation(uint8_t x) override;
+    void startWrite() override;
+    void endWrite() override;
+
+    void setAddrWindow(int x1, int y1, int x2, int y2);
+    void pushColors(uint16_t *data, uint8_t len, boolean first);
+    uint16_t color565(uint8_t r, uint8_t g, uint8_t b);
+
+    /*!
+       @brief    Work done since the last reset of the counters
+       @returns the counters
+    */
+    const TFTLCDStats& hostStats() const;
+
+    /*!
+       @brief    Clear the work counters
+    */
+    void hostResetStats();
+
+    /*!
+       @brief    Read back one pixel of the panel, unrotated coordinates
+       @param x   column 0 to TFTWIDTH - 1
+       @param y   row 0 to TFTHEIGHT - 1
+       @returns the 565 color
+    */
+    uint16_t hostPixel(int16_t x, int16_t y) const;
+
+    /*!
+       @brief    Save the panel content as a binary PPM image, unrotated
+       @param path   file to write
+       @returns true on success
+    */
+    boolean hostWritePPM(const char *path) const;
+
+    /*!
+       @brief    Bus writes strobed while the chip select, the command/data pin
+                 or a data line was not an output, as it is while the touch
+                 panel shares them; on the board they land on floating lines
+       @returns the write count since reset, not cleared by hostResetStats
+    */
+    uint32_t hostStrayWrites() const;
+
+  private:
+    uint16_t m_framebuffer[TFTWIDTH * TFTHEIGHT];
+    TFTLCDStats m_stats{};
+    uint8_t m_writeDepth{};   // startWrite nesting
+    uint8_t m_cs{0xFF};       // chip select pin, 0xFF for the shield default
+    uint8_t m_cd{0xFF};       // command/data pin
+    uint32_t m_strayWrites{};
+    int16_t m_windowX1{}, m_windowY1{}, m_windowX2{}, m_windowY2{};
+    int16_t m_cursorX{}, m_cursorY{};
+
+    void flood(uint16_t color, uint32_t len);
+    void setLR(void);
+    void writePixelData(uint16_t color);
+    boolean hostBusDriven() const;
+    void account(uint32_t busWrites);
+};
+
+#endif // _HostAdafruit_TFTLCD_H_
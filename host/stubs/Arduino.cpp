@@ -0,0 +1,233 @@
+/*!
+   @file Arduino.cpp
+
+   This is part of the TFT Virtual Segment Display for Arduino
+   Host stand-in for the Arduino core, enough to build the chess clock on Linux.
+
+
+   Written by Enrique Albertos, with
+   contributions from the open source community.
+
+   Public Domain
+
+*/
+
+#include "Arduino.h"
+
+HardwareSerial Serial;
+
+static uint64_t s_micros = 0;  // virtual time since reset
+static uint64_t s_horizon = 0;  // hostTimerSleep stops here
+static uint32_t s_wakeLatency = 0;
+
+static const uint8_t PINS = 20;
+static uint8_t s_pinModes[PINS] = {};
+static uint8_t s_pinLevels[PINS] = {};
+static int (*s_analogSource)(uint8_t) = nullptr;
+static uint32_t s_progmemCopied = 0;
+
+static const uint32_t TIMER_TICK_MICROS = 4;  // Timer1 at 16 MHz / 64
+
+unsigned long millis() {
+  return s_micros / 1000;
+}
+
+unsigned long micros() {
+  return s_micros;
+}
+
+void hostAdvanceMicros(uint32_t us) {
+  s_micros += us;
+}
+
+void hostSetMicros(uint64_t us) {
+  s_micros = us;
+}
+
+boolean hostTimerSleep(uint32_t us) {
+  const uint64_t wake = s_micros + (us + TIMER_TICK_MICROS - 1) / TIMER_TICK_MICROS * TIMER_TICK_MICROS + s_wakeLatency;
+  if (wake > s_horizon) {
+    s_micros = s_horizon > s_micros ? s_horizon : s_micros;
+    return false;
+  }
+  s_micros = wake;
+  return true;
+}
+
+void hostTimerSetHorizon(uint64_t us) {
+  s_horizon = us;
+}
+
+void hostTimerSetWakeLatency(uint32_t us) {
+  s_wakeLatency = us;
+}
+
+void* memcpy_P(void* dest, const void* src, size_t n) {
+  s_progmemCopied += n;
+  return memcpy(dest, src, n);
+}
+
+uint32_t hostProgmemCopied() {
+  return s_progmemCopied;
+}
+
+void delay(unsigned long ms) {
+  s_micros += ms * 1000;
+}
+
+void delayMicroseconds(unsigned int us) {
+  s_micros += us;
+}
+
+void pinMode(uint8_t pin, uint8_t mode) {
+  if (pin < PINS) {
+    s_pinModes[pin] = mode;
+  }
+}
+
+void digitalWrite(uint8_t pin, uint8_t value) {
+  if (pin < PINS) {
+    s_pinLevels[pin] = value;
+  }
+}
+
+int digitalRead(uint8_t pin) {
+  return hostPinLevel(pin);
+}
+
+int analogRead(uint8_t pin) {
+  return s_analogSource ? s_analogSource(pin) : 0;
+}
+
+uint8_t hostPinMode(uint8_t pin) {
+  return pin < PINS ? s_pinModes[pin] : INPUT;
+}
+
+uint8_t hostPinLevel(uint8_t pin) {
+  return pin < PINS ? s_pinLevels[pin] : LOW;
+}
+
+void hostSetAnalogSource(int (*source)(uint8_t pin)) {
+  s_analogSource = source;
+}
+
+long map(long value, long fromLow, long fromHigh, long toLow, long toHigh) {
+  return (value - fromLow) * (toHigh - toLow) / (fromHigh - fromLow) + toLow;
+}
+
+size_t Print::write(const char *str) {
+  size_t n = 0;
+  while (*str) {
+    n += write(static_cast<uint8_t>(*str++));
+  }
+  return n;
+}
+
+size_t Print::print(const __FlashStringHelper *str) {
+  return write(reinterpret_cast<const char *>(str));
+}
+
+size_t Print::print(const char *str) {
+  return write(str);
+}
+
+size_t Print::print(char c) {
+  return write(static_cast<uint8_t>(c));
+}
+
+size_t Print::print(int n, int base) {
+  return print(static_cast<long>(n), base);
+}
+
+size_t Print::print(unsigned int n, int base) {
+  return printNumber(n, base);
+}
+
+size_t Print::print(long n, int base) {
+  if (n < 0 && base == 10) {
+    return write('-') + printNumber(-n, base);
+  }
+  return printNumber(n, base);
+}
+
+size_t Print::print(unsigned long n, int base) {
+  return printNumber(n, base);
+}
+
+size_t Print::println(const __FlashStringHelper *str) {
+  return print(str) + println();
+}
+
+size_t Print::println(const char *str) {
+  return print(str) + println();
+}
+
+size_t Print::println(int n, int base) {
+  return print(n, base) + println();
+}
+
+size_t Print::println(unsigned int n, int base) {
+  return print(n, base) + println();
+}
+
+size_t Print::println(long n, int base) {
+  return print(n, base) + println();
+}
+
+size_t Print::println(unsigned long n, int base) {
+  return print(n, base) + println();
+}
+
+size_t Print::println() {
+  return write('\r') + write('\n');
+}
+
+size_t Print::printNumber(unsigned long n, int base) {
+  char buffer[8 * sizeof(long) + 1];
+  char *str = &buffer[sizeof(buffer) - 1];
+  *str = '\0';
+  if (base < 2) {
+    base = 10;
+  }
+  do {
+    const char digit = n % base;
+    n /= base;
+    *--str = digit < 10 ? digit + '0' : digit + 'A' - 10;
+  } while (n);
+  return write(str);
+}
+
+int HardwareSerial::available() {
+  return static_cast<uint8_t>(m_tail - m_head) % sizeof(m_input);
+}
+
+int HardwareSerial::read() {
+  if (m_head == m_tail) {
+    return -1;
+  }
+  const char c = m_input[m_head];
+  m_head = (m_head + 1) % sizeof(m_input);
+  return c;
+}
+
+size_t HardwareSerial::write(uint8_t c) {
+  if (m_out && c != '\r') {
+    fputc(c, m_out);
+  }
+  return 1;
+}
+
+void HardwareSerial::hostOutput(FILE *out) {
+  m_out = out;
+}
+
+void HardwareSerial::hostInput(const char *text) {
+  while (*text) {
+    const uint8_t next = (m_tail + 1) % sizeof(m_input);
+    if (next == m_head) {
+      return;
+    }
+    m_input[m_tail] = *text++;
+    m_tail = next;
+  }
+}
@@ -0,0 +1,188 @@
+/*!
+   @file Arduino.h
+
+   This is part of the TFT Virtual Segment Display for Arduino
+   Host stand-in for the Arduino core, enough to build the chess clock on Linux.
+   Time is virtual and only moves when the host driver advances it.
+
+
+   Written by Enrique Albertos, with
+   contributions from the open source community.
+
+   Public Domain
+
+*/
+
+#ifndef _HostArduino_H_
+#define _HostArduino_H_
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "binary.h"
+
+typedef bool boolean;
+typedef uint8_t byte;
+
+// flash is ordinary memory on the host
+#define PROGMEM
+#define strlen_P strlen
+#define pgm_read_byte(addr) (*(const uint8_t *)(addr))
+#define pgm_read_word(addr) (*(const uint16_t *)(addr))
+#define pgm_read_dword(addr) (*(const uint32_t *)(addr))
+#define pgm_read_ptr(addr) (*(void * const *)(addr))
+
+class __FlashStringHelper;
+#define F(string_literal) (reinterpret_cast<const __FlashStringHelper *>(string_literal))
+
+#define A0 14
+#define A1 15
+#define A2 16
+#define A3 17
+#define A4 18
+#define A5 19
+
+#define INPUT 0x0
+#define OUTPUT 0x1
+#define LOW 0x0
+#define HIGH 0x1
+
+#define noInterrupts()
+#define interrupts()
+
+unsigned long millis();
+unsigned long micros();
+void delay(unsigned long ms);
+void delayMicroseconds(unsigned int us);
+void pinMode(uint8_t pin, uint8_t mode);
+void digitalWrite(uint8_t pin, uint8_t value);
+int digitalRead(uint8_t pin);
+int analogRead(uint8_t pin);
+long map(long value, long fromLow, long fromHigh, long toLow, long toHigh);
+
+/*!
+   @brief    Copy from flash, flash is ordinary memory on the host but the bytes
+             are counted, on the board they go to RAM one lpm at a time
+   @param dest   RAM destination
+   @param src    flash source
+   @param n      bytes to copy
+   @returns dest
+*/
+void* memcpy_P(void* dest, const void* src, size_t n);
+
+/*!
+   @returns the bytes copied by memcpy_P since reset
+*/
+uint32_t hostProgmemCopied();
+
+/*!
+   @brief    Advance the virtual clock returned by millis() and micros()
+   @param us   microseconds to advance
+*/
+void hostAdvanceMicros(uint32_t us);
+
+/*!
+   @brief    Set the virtual clock returned by millis() and micros()
+   @param us   microseconds since reset
+*/
+void hostSetMicros(uint64_t us);
+
+/*!
+   @brief    Mode of a pin as set by pinMode
+   @param pin   pin number
+   @returns INPUT or OUTPUT
+*/
+uint8_t hostPinMode(uint8_t pin);
+
+/*!
+   @brief    Level of a pin as set by digitalWrite
+   @param pin   pin number
+   @returns LOW or HIGH
+*/
+uint8_t hostPinLevel(uint8_t pin);
+
+/*!
+   @brief    Model that answers analogRead, 0 for every pin without one
+   @param source   function returning the ADC reading of a pin, nullptr for none
+*/
+void hostSetAnalogSource(int (*source)(uint8_t pin));
+
+/*!
+   @brief    Simulated Timer1 compare wake up: advance the virtual clock to the
+             first 4 us timer tick after the wait plus the wake up latency
+   @param us   time to sleep
+   @returns false if the host horizon came first, the clock stops there
+*/
+boolean hostTimerSleep(uint32_t us);
+
+/*!
+   @brief    Virtual time at which hostTimerSleep gives control back to the host
+   @param us   microseconds since reset
+*/
+void hostTimerSetHorizon(uint64_t us);
+
+/*!
+   @brief    Delay between the timer compare and the code running again
+   @param us   microseconds, 0 by default
+*/
+void hostTimerSetWakeLatency(uint32_t us);
+
+/** Text output, same overloads as the Arduino Print class */
+class Print {
+  public:
+    virtual ~Print() {}
+    virtual size_t write(uint8_t) = 0;
+
+    size_t write(const char *str);
+    size_t print(const __FlashStringHelper *);
+    size_t print(const char *);
+    size_t print(char);
+    size_t print(int, int = 10);
+    size_t print(unsigned int, int = 10);
+    size_t print(long, int = 10);
+    size_t print(unsigned long, int = 10);
+    size_t println(const __FlashStringHelper *);
+    size_t println(const char *);
+    size_t println(int, int = 10);
+    size_t println(unsigned int, int = 10);
+    size_t println(long, int = 10);
+    size_t println(unsigned long, int = 10);
+    size_t println();
+
+  private:
+    size_t printNumber(unsigned long, int);
+};
+
+/** Serial port stand-in, output goes to a host stream, input is queued by the host */
+class HardwareSerial : public Print {
+  public:
+    void begin(unsigned long) {}
+    int available();
+    int read();
+    size_t write(uint8_t) override;
+    using Print::write;
+
+    /*!
+       @brief    Send the serial output to a host stream
+       @param out   stream, nullptr discards the output
+    */
+    void hostOutput(FILE *out);
+
+    /*!
+       @brief    Queue characters to be read by the sketch
+       @param text   characters to queue
+    */
+    void hostInput(const char *text);
+
+  private:
+    FILE *m_out{};
+    char m_input[64]{};
+    uint8_t m_head{};
+    uint8_t m_tail{};
+};
+
+extern HardwareSerial Serial;
+
+#endif // _HostArduino_H_
@@ -0,0 +1,84 @@
+/*!
+   @file TouchScreen.cpp
+
+   This is part of the TFT Virtual Segment Display for Arduino
+   Host stand-in for the Adafruit TouchScreen library
+
+
+   Written by Enrique Albertos, with
+   contributions from the open source community.
+
+   Public Domain
+
+*/
+
+#include "TouchScreen.h"
+
+TSPoint TouchScreen::s_point;
+
+static uint8_t s_xp, s_yp, s_xm, s_ym;
+static uint16_t s_rxplate;
+
+TouchScreen::TouchScreen(uint8_t, uint8_t, uint8_t, uint8_t, uint16_t) {}
+
+TSPoint TouchScreen::getPoint(void) const {
+  return s_point;
+}
+
+uint16_t TouchScreen::pressure(void) const {
+  return s_point.z;
+}
+
+int TouchScreen::readTouchX(void) const {
+  return s_point.x;
+}
+
+int TouchScreen::readTouchY(void) const {
+  return s_point.y;
+}
+
+void TouchScreen::hostPress(int16_t x, int16_t y, int16_t z) {
+  s_point = TSPoint(x, y, z);
+}
+
+void TouchScreen::hostRelease(void) {
+  s_point = TSPoint();
+}
+
+void TouchScreen::hostConnect(uint8_t xp, uint8_t yp, uint8_t xm, uint8_t ym, uint16_t rxplate) {
+  s_xp = xp;
+  s_yp = yp;
+  s_xm = xm;
+  s_ym = ym;
+  s_rxplate = rxplate;
+  hostSetAnalogSource(analogPanel);
+}
+
+/*!
+   @brief    Reading of an analog pin, the inverse of the TouchScreen library
+             formulas for the plates the other pins drive
+   @param pin   X- or Y+
+   @returns ADC reading
+*/
+int TouchScreen::analogPanel(uint8_t pin) {
+  const bool touched = s_point.z > 0;
+  if (hostPinMode(s_xp) == OUTPUT && hostPinMode(s_ym) == OUTPUT &&
+      hostPinLevel(s_xp) == LOW && hostPinLevel(s_ym) == HIGH) {
+    // pressure: z = x * rxplate * (z2 - z1) / z1 / 1024 with z2 at full scale
+    if (!touched) {
+      return pin == s_xm ? 0 : 1023;
+    }
+    const long plate = (long)s_point.x * s_rxplate;
+    return pin == s_xm ? 1023 * plate / (plate + (long)s_point.z * 1024) : 1023;
+  }
+  if (!touched) {
+    return 0;
+  }
+  if (pin == s_yp && hostPinLevel(s_xp) == HIGH && hostPinLevel(s_xm) == LOW) {
+    return 1023 - s_point.x;
+  }
+  if (pin == s_xm && hostPinLevel(s_yp) == HIGH && hostPinLevel(s_ym) == LOW) {
+    return 1023 - s_point.y;
+  }
+  return 0;
+}
@@ -0,0 +1,76 @@
+/*!
+   @file TouchScreen.h
+
+   This is part of the TFT Virtual Segment Display for Arduino
+   Host stand-in for the Adafruit TouchScreen library. The host driver
+   decides what the panel reads, in raw ADC units. Once connected, the
+   panel also answers analogRead from the plates the pins drive.
+
+
+   Written by Enrique Albertos, with
+   contributions from the open source community.
+
+   Public Domain
+
+*/
+
+#ifndef _HostTouchScreen_H_
+#define _HostTouchScreen_H_
+
+#include "Arduino.h"
+
+class TSPoint {
+  public:
+    TSPoint(void) : x(0), y(0), z(0) {}
+    TSPoint(int16_t x0, int16_t y0, int16_t z0) : x(x0), y(y0), z(z0) {}
+
+    bool operator==(TSPoint p) const {
+      return ((p.x == x) && (p.y == y) && (p.z == z));
+    }
+    bool operator!=(TSPoint p) const {
+      return ((p.x != x) || (p.y != y) || (p.z != z));
+    }
+
+    int16_t x, y, z;
+};
+
+class TouchScreen {
+  public:
+    TouchScreen(uint8_t xp, uint8_t yp, uint8_t xm, uint8_t ym, uint16_t rx);
+
+    TSPoint getPoint(void) const;
+    uint16_t pressure(void) const;
+    int readTouchX(void) const;
+    int readTouchY(void) const;
+
+    /*!
+       @brief    Press the panel, every read returns this point until released
+       @param x   raw x reading
+       @param y   raw y reading
+       @param z   raw pressure
+    */
+    static void hostPress(int16_t x, int16_t y, int16_t z);
+
+    /*!
+       @brief    Release the panel, reads return zero pressure
+    */
+    static void hostRelease(void);
+
+    /*!
+       @brief    Wire the panel to the pins, analogRead of X- and Y+ then returns
+                 what the plates read for the driven pins
+       @param xp        X+ pin
+       @param yp        Y+ pin
+       @param xm        X- pin
+       @param ym        Y- pin
+       @param rxplate   resistance across the X plate
+    */
+    static void hostConnect(uint8_t xp, uint8_t yp, uint8_t xm, uint8_t ym, uint16_t rxplate);
+
+  private:
+    static TSPoint s_point;
+
+    static int analogPanel(uint8_t pin);
+};
+
+#endif // _HostTouchScreen_H_
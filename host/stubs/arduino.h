@@ -0,0 +1,2 @@
+// The sketch sources include the core with its lowercase name
+#include "Arduino.h"
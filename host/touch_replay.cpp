@@ -0,0 +1,134 @@
+/*!
+   @file touch_replay.cpp
+
+   This is part of the TFT Virtual Segment Display for Arduino
+   Replays a recorded touch trace into the chess clock sketch on virtual
+   time. Counts the turn flips, measures the shortest flip to flip interval
+   and the press to flip latency, and fails if the flips differ from the
+   ones the trace expects or if the LCD was written while the touch panel
+   held the pins they share.
+
+   usage: touch_replay trace
+
+   Trace lines, times in milliseconds from the first press, positions in
+   screen coordinates of the initial rotation:
+
+     # expect <flips>
+     <ms> press <x> <y> [pressure]
+     <ms> release
+
+
+   Written by Enrique Albertos, with
+   contributions from the open source community.
+
+   Public Domain
+
+*/
+
+#include "Arduino.h"
+#include "chessclock.ino"
+
+// late wake ups, as on the board, let the touch readings drift against the clock
+// boundaries instead of staying on the same grid
+#define REPLAY_WAKE_LATENCY_MICROS 30
+
+static uint32_t s_flips = 0;
+static uint64_t s_lastFlip = 0;
+static uint64_t s_minFlipToFlip = UINT64_MAX;
+static uint64_t s_lastPress = 0;
+static uint64_t s_maxLatency = 0;
+
+static uint16_t totalMoves() {
+  return clockEngine.moves(ClockEngine::WHITES) + clockEngine.moves(ClockEngine::BLACKS);
+}
+
+/*!
+   @brief    Run the sketch up to a virtual time, noting every turn flip
+   @param end   virtual microseconds
+*/
+static void runUntil(uint64_t end) {
+  hostTimerSetHorizon(end);
+  uint16_t moves = totalMoves();
+  while (micros() < end) {
+    loop();
+    if (totalMoves() < moves) {
+      moves = totalMoves();  // a reset is not a flip
+    } else if (totalMoves() != moves) {
+      moves = totalMoves();
+      const uint64_t now = micros();
+      if (s_flips > 0 && now - s_lastFlip < s_minFlipToFlip) {
+        s_minFlipToFlip = now - s_lastFlip;
+      }
+      if (now - s_lastPress > s_maxLatency) {
+        s_maxLatency = now - s_lastPress;
+      }
+      s_lastFlip = now;
+      ++s_flips;
+    }
+  }
+}
+
+int main(int argc, char **argv) {
+  if (argc < 2) {
+    fprintf(stderr, "usage: %s trace\n", argv[0]);
+    return 2;
+  }
+  FILE *trace = fopen(argv[1], "r");
+  if (!trace) {
+    fprintf(stderr, "cannot read %s\n", argv[1]);
+    return 2;
+  }
+
+  TouchScreen::hostConnect(XP, YP, XM, YM, 300);
+  hostTimerSetWakeLatency(REPLAY_WAKE_LATENCY_MICROS);
+  setup();
+  runUntil(micros() + 1000000ULL);
+  const uint64_t start = micros();
+
+  long expected = -1;
+  int pressX = -1;   // position of the finger on the panel, -1 when lifted
+  int pressY = -1;
+  char line[128];
+  while (fgets(line, sizeof(line), trace)) {
+    unsigned long ms;
+    int x, y;
+    int z = (MINPRESSURE + MAXPRESSURE) / 2;
+    char action[16];
+    if (sscanf(line, "# expect %ld", &expected) == 1 || line[0] == '#') {
+      continue;
+    }
+    const int fields = sscanf(line, "%lu %15s %d %d %d", &ms, action, &x, &y, &z);
+    if (fields < 2) {
+      continue;
+    }
+    runUntil(start + ms * 1000ULL);
+    if (strcmp(action, "press") == 0 && fields >= 4) {
+      // the raw readings are the inverse of the sketch calibration
+      if (x != pressX || y != pressY) {
+        s_lastPress = micros();
+        pressX = x;
+        pressY = y;
+      }
+      TouchScreen::hostPress(TS_RT + (long)x * (TS_LEFT - TS_RT) / TFTWIDTH,
+                             TS_BOT + (long)y * (TS_TOP - TS_BOT) / TFTHEIGHT, z);
+    } else if (strcmp(action, "release") == 0) {
+      TouchScreen::hostRelease();
+      pressX = pressY = -1;
+    } else {
+      fprintf(stderr, "bad trace line: %s", line);
+      return 2;
+    }
+  }
+  fclose(trace);
+  runUntil(micros() + 500000ULL);
+
+  printf("%-28s flips %3lu expected %3ld  min flip to flip %6.1f ms  max press to flip %5.1f ms\n",
+         argv[1], (unsigned long)s_flips, expected,
+         s_flips > 1 ? s_minFlipToFlip / 1000.0 : 0.0, s_maxLatency / 1000.0);
+  if (tft.hostStrayWrites() > 0) {
+    fprintf(stderr, "%s: %lu LCD writes while the touch panel held its pins\n", argv[1],
+            (unsigned long)tft.hostStrayWrites());
+    return 1;
+  }
+  return expected < 0 || (long)s_flips == expected ? 0 : 1;
+}